@@ -0,0 +1,40 @@
+# SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+# SPDX-License-Identifier: MIT
+
+include_guard(GLOBAL)
+
+find_package(Catch2 CONFIG REQUIRED)
+
+if (CMAKE_SOURCE_DIR STREQUAL PROJECT_SOURCE_DIR)
+  find_package(injectx CONFIG REQUIRED)
+endif()
+
+# all benchmarks are built by this target, they are not part of ctest
+if (NOT TARGET benchmarks)
+  add_custom_target(benchmarks)
+endif()
+
+# sets all nessary default things
+function(add_injectx_benchmark benchmark_name)
+  cmake_path(
+    RELATIVE_PATH CMAKE_CURRENT_LIST_DIR
+    BASE_DIRECTORY "${PROJECT_SOURCE_DIR}"
+    OUTPUT_VARIABLE module_name
+  )
+
+  set(benchmark_file "${benchmark_name}_benchmark.cpp")
+  set(benchmark_target "bench-${module_name}-${benchmark_name}")
+  string(REPLACE "_" "-" benchmark_target "${benchmark_target}")
+
+  add_executable(${benchmark_target} "${benchmark_file}")
+  add_dependencies(benchmarks ${benchmark_target})
+
+  target_link_libraries(
+    ${benchmark_target}
+      PRIVATE
+        injectx::${module_name}
+        Catch2::Catch2WithMain
+  )
+
+  set(injectx_benchmark_target ${benchmark_target} PARENT_SCOPE)
+endfunction()
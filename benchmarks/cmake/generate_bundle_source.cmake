@@ -0,0 +1,48 @@
+# SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+# SPDX-License-Identifier: MIT
+
+include_guard(GLOBAL)
+
+# Writes a translation unit with a bundle of `size` synthetic modules. Module
+# i provides `int m<i>` and requires the fields of modules i - 1 and i / 2, so
+# the graph is sparse (at most two edges per module) and fully connected.
+function(generate_bundle_source file size)
+  set(source "// generated by generate_bundle_source.cmake, do not edit\n\n")
+  string(APPEND source "#include \"injectx/core/bundle.hpp\"\n\n")
+
+  set(setups "")
+  math(EXPR last "${size} - 1")
+  foreach(i RANGE ${last})
+    string(APPEND source "namespace bench::modules::m${i} {\n\n")
+    string(APPEND source "struct Provides {\n  int m${i};\n};\n\n")
+
+    if (i EQUAL 0)
+      string(APPEND source "injectx::core::SetupTask<Provides> setup() {\n")
+    else()
+      math(EXPR previous "${i} - 1")
+      math(EXPR parent "${i} / 2")
+      string(APPEND source "struct Requires {\n  int m${previous};\n")
+      if (NOT parent EQUAL previous)
+        string(APPEND source "  int m${parent};\n")
+      endif()
+      string(APPEND source "};\n\n")
+      string(APPEND source
+        "injectx::core::SetupTask<Provides> setup(Requires) {\n")
+    endif()
+
+    string(APPEND source "  co_yield {};\n}\n\n")
+    string(APPEND source "}  // namespace bench::modules::m${i}\n\n")
+    list(APPEND setups "    bench::modules::m${i}::setup")
+  endforeach()
+
+  list(JOIN setups ",\n" setups)
+  string(APPEND source "namespace bench {\n\n")
+  string(APPEND source "constexpr auto bundle = injectx::core::makeBundle<\n")
+  string(APPEND source "${setups}>();\n\n")
+  string(APPEND source "static_assert(bundle.has_value());\n")
+  string(APPEND source "static_assert(bundle->size() == ${size});\n\n")
+  string(APPEND source "}  // namespace bench\n")
+
+  # keep the timestamp, so re-configuring does not trigger a rebuild
+  file(CONFIGURE OUTPUT "${file}" CONTENT "${source}" @ONLY)
+endfunction()
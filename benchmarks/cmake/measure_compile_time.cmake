@@ -0,0 +1,92 @@
+# SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+# SPDX-License-Identifier: MIT
+
+# Included by the generated measure_compile_time.cmake script (cmake -P) in
+# <build>/benchmarks/compile_time, rebuilds every generated bundle translation
+# unit and writes `modules,status,wall_ms,seconds,max_rss_kb` lines into
+# OUTPUT_FILE.
+#
+#   BINARY_DIR  - build tree to run `cmake --build` in
+#   CONFIG      - build configuration, optional for single-config generators
+#   SOURCE_DIR  - directory with generated bundle_<size>.cpp and .time files
+#   SIZES       - list of bundle sizes
+#   OUTPUT_FILE - csv file with results
+
+foreach(var BINARY_DIR SOURCE_DIR SIZES OUTPUT_FILE)
+  if (NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+set(config_args "")
+if (CONFIG)
+  set(config_args --config "${CONFIG}")
+endif()
+
+function(_build target out_result out_error)
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} --build "${BINARY_DIR}" ${config_args}
+            --target ${target}
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+  )
+
+  set(${out_result} ${result} PARENT_SCOPE)
+  set(${out_error} "${output}" PARENT_SCOPE)
+endfunction()
+
+# the library itself must not be part of the measurement
+_build(injectx-core result error)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "Failed to build injectx-core:\n${error}")
+endif()
+
+set(csv "modules,status,wall_ms,seconds,max_rss_kb\n")
+set(largest 0)
+
+foreach(size IN LISTS SIZES)
+  set(source "${SOURCE_DIR}/bundle_${size}.cpp")
+  set(time_file "${SOURCE_DIR}/bundle_${size}.time")
+
+  file(REMOVE "${time_file}")
+  file(TOUCH "${source}")
+
+  string(TIMESTAMP start "%s%f")
+  _build(bench-compile-time-bundle-${size} result error)
+  string(TIMESTAMP stop "%s%f")
+
+  # wall time includes the build tool, seconds and max rss are measured for
+  # the compiler alone when GNU time is the launcher, its last line is
+  # "<seconds>,<max rss>"
+  math(EXPR wall_ms "(${stop} - ${start}) / 1000")
+  set(seconds "n/a")
+  set(max_rss "n/a")
+  if (EXISTS "${time_file}")
+    file(STRINGS "${time_file}" lines)
+    list(GET lines -1 last)
+    string(REPLACE "," ";" last "${last}")
+    list(GET last 0 seconds)
+    list(GET last 1 max_rss)
+  endif()
+
+  if (result EQUAL 0)
+    set(status "ok")
+    if (size GREATER largest)
+      set(largest ${size})
+    endif()
+  elseif (error MATCHES "constexpr|constant expression|evaluation exceeded")
+    set(status "constexpr-limit")
+  else()
+    set(status "failed")
+  endif()
+
+  message(STATUS
+    "${size} modules: ${status}, wall ${wall_ms} ms, "
+    "compiler ${seconds} s, ${max_rss} KB")
+  string(APPEND csv "${size},${status},${wall_ms},${seconds},${max_rss}\n")
+endforeach()
+
+file(WRITE "${OUTPUT_FILE}" "${csv}")
+message(STATUS "Largest bundle compiled: ${largest} modules")
+message(STATUS "Results: ${OUTPUT_FILE}")
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/dependency_container.hpp"
+#include "injectx/core/static_dependency_container.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace injectx::core::benchmarks {
+
+struct Ints1 {
+  int i0;
+};
+
+struct Ints4 {
+  int i0;
+  int i1;
+  int i2;
+  int i3;
+};
+
+struct Ints16 {
+  int i0;
+  int i1;
+  int i2;
+  int i3;
+  int i4;
+  int i5;
+  int i6;
+  int i7;
+  int i8;
+  int i9;
+  int i10;
+  int i11;
+  int i12;
+  int i13;
+  int i14;
+  int i15;
+};
+
+struct Objects {
+  std::string string;
+  std::shared_ptr<int> pointer;
+  std::vector<int> vector;
+};
+
+struct ObjectsRef {
+  Ref<std::string> string;
+  Ref<std::shared_ptr<int>> pointer;
+  Ref<std::vector<int>> vector;
+};
+
+[[nodiscard]] Objects makeObjects() {
+  return {
+      .string = std::string(64, 'x'),
+      .pointer = std::make_shared<int>(42),
+      .vector = std::vector<int>(1024)};
+}
+
+template<typename Container, typename Provides>
+void benchmarkProvide(std::string_view name, const Provides &provides) {
+  BENCHMARK_ADVANCED(std::string{name})(Catch::Benchmark::Chronometer meter) {
+    std::vector<Container> containers(meter.runs());
+    meter.measure([&](int run) {
+      return containers[run].provide(provides).has_value();
+    });
+  };
+}
+
+template<typename Requires, typename Container>
+void benchmarkResolve(std::string_view name, const Container &container) {
+  BENCHMARK(std::string{name}) {
+    return container.template resolve<Requires>();
+  };
+}
+
+TEST_CASE("dependency-container-provide") {
+  benchmarkProvide<DependencyContainer>("1 int", Ints1{});
+  benchmarkProvide<DependencyContainer>("4 ints", Ints4{});
+  benchmarkProvide<DependencyContainer>("16 ints", Ints16{});
+  benchmarkProvide<DependencyContainer>("objects", makeObjects());
+
+  BENCHMARK_ADVANCED("objects by move")(Catch::Benchmark::Chronometer meter) {
+    std::vector<DependencyContainer> containers(meter.runs());
+    std::vector<Objects> objects(meter.runs(), makeObjects());
+    meter.measure([&](int run) {
+      return containers[run].provide(std::move(objects[run])).has_value();
+    });
+  };
+}
+
+TEST_CASE("dependency-container-resolve") {
+  DependencyContainer container;
+  REQUIRE(container.provide(Ints16{}).has_value());
+  REQUIRE(container.provide(makeObjects()).has_value());
+
+  benchmarkResolve<Ints1>("1 int", container);
+  benchmarkResolve<Ints4>("4 ints", container);
+  benchmarkResolve<Ints16>("16 ints", container);
+  benchmarkResolve<Objects>("objects", container);
+  benchmarkResolve<ObjectsRef>("objects by reference", container);
+}
+
+using StaticContainer = StaticDependencyContainer<Ints16, Objects>;
+
+TEST_CASE("static-dependency-container-provide") {
+  benchmarkProvide<StaticContainer>("16 ints", Ints16{});
+  benchmarkProvide<StaticContainer>("objects", makeObjects());
+}
+
+TEST_CASE("static-dependency-container-resolve") {
+  StaticContainer container;
+  REQUIRE(container.provide(Ints16{}).has_value());
+  REQUIRE(container.provide(makeObjects()).has_value());
+
+  benchmarkResolve<Ints1>("1 int", container);
+  benchmarkResolve<Ints4>("4 ints", container);
+  benchmarkResolve<Ints16>("16 ints", container);
+  benchmarkResolve<Objects>("objects", container);
+  benchmarkResolve<ObjectsRef>("objects by reference", container);
+}
+
+}  // namespace injectx::core::benchmarks
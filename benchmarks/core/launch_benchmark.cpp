@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/launch.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace injectx::core::benchmarks {
+
+// Synthetic modules: module I provides Node<I> and requires the node of its
+// parent, so the parent function defines the shape of the bundle graph.
+template<std::size_t I>
+struct Node {
+  std::size_t id{I};
+};
+
+namespace modules {
+
+// module name is taken from the namespace after modules::, i.e. synthetic<I>
+template<std::size_t I>
+struct synthetic {
+  struct Provides {
+    Node<I> node;
+  };
+};
+
+}  // namespace modules
+
+template<std::size_t I>
+using Provides = typename modules::synthetic<I>::Provides;
+
+template<std::size_t I>
+struct Requires {
+  Node<I> node;
+};
+
+template<std::size_t I>
+SetupTask<Provides<I>> root() {
+  co_yield Provides<I>{};
+}
+
+template<std::size_t I, std::size_t Parent>
+SetupTask<Provides<I>> node(Requires<Parent>) {
+  co_yield Provides<I>{};
+}
+
+// no dependencies at all
+template<std::size_t Size>
+inline constexpr auto independent =
+    []<std::size_t... I>(std::index_sequence<I...>) {
+      return makeBundle<root<I>...>().value();
+    }(std::make_index_sequence<Size>{});
+
+// every module depends on the previous one
+template<std::size_t Size>
+inline constexpr auto chain =
+    []<std::size_t... I>(std::index_sequence<I...>) {
+      return makeBundle<root<0>, node<I + 1, I>...>().value();
+    }(std::make_index_sequence<Size - 1>{});
+
+// binary tree, every module depends on its parent
+template<std::size_t Size>
+inline constexpr auto tree =
+    []<std::size_t... I>(std::index_sequence<I...>) {
+      return makeBundle<root<0>, node<I + 1, I / 2>...>().value();
+    }(std::make_index_sequence<Size - 1>{});
+
+void benchmarkLaunch(
+    std::string_view name, Bundle bundle, std::size_t threads = 1) {
+  BENCHMARK(fmt::format(
+      "{} {} modules, {} threads", name, bundle.size(), threads)) {
+    auto task = launch(bundle, {.threads = threads});
+    const auto init = task.init();
+    return init.has_value() && task.teardown().has_value();
+  };
+}
+
+TEST_CASE("launch-10") {
+  benchmarkLaunch("independent", independent<10>);
+  benchmarkLaunch("independent", independent<10>, 4);
+  benchmarkLaunch("chain", chain<10>);
+  benchmarkLaunch("tree", tree<10>);
+  benchmarkLaunch("tree", tree<10>, 4);
+}
+
+TEST_CASE("launch-100") {
+  benchmarkLaunch("independent", independent<100>);
+  benchmarkLaunch("independent", independent<100>, 4);
+  benchmarkLaunch("chain", chain<100>);
+  benchmarkLaunch("tree", tree<100>);
+  benchmarkLaunch("tree", tree<100>, 4);
+}
+
+// makeBundle of 1000 modules needs raised constexpr limits, see
+// INJECTX_BENCHMARK_LARGE_BUNDLES in benchmarks/CMakeLists.txt
+#ifdef INJECTX_BENCHMARK_LARGE_BUNDLES
+TEST_CASE("launch-1000") {
+  benchmarkLaunch("independent", independent<1000>);
+  benchmarkLaunch("independent", independent<1000>, 4);
+  benchmarkLaunch("chain", chain<1000>);
+  benchmarkLaunch("tree", tree<1000>);
+  benchmarkLaunch("tree", tree<1000>, 4);
+}
+#endif  // INJECTX_BENCHMARK_LARGE_BUNDLES
+
+}  // namespace injectx::core::benchmarks
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/module.hpp"
+#include "injectx/core/setup_task.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace injectx::core::benchmarks {
+
+namespace modules::empty {
+
+SetupTask<void> setup() {
+  co_yield {};
+}
+
+}  // namespace modules::empty
+
+namespace modules::producer {
+
+struct Provides {
+  int value;
+};
+
+SetupTask<Provides> setup() {
+  co_yield Provides{.value = 42};
+}
+
+}  // namespace modules::producer
+
+namespace modules::consumer {
+
+struct Requires {
+  int value;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield {};
+}
+
+}  // namespace modules::consumer
+
+TEST_CASE("setup-task") {
+  BENCHMARK("create") {
+    return modules::empty::setup();
+  };
+
+  BENCHMARK("init") {
+    auto task = modules::empty::setup();
+    return task.init().has_value();
+  };
+
+  BENCHMARK("init and teardown") {
+    auto task = modules::empty::setup();
+    const auto init = task.init();
+    return init.has_value() && task.teardown().has_value();
+  };
+}
+
+TEST_CASE("module-setup") {
+  constexpr auto producer = makeModule<modules::producer::setup>();
+  constexpr auto consumer = makeModule<modules::consumer::setup>();
+
+  BENCHMARK_ADVANCED("provide")(Catch::Benchmark::Chronometer meter) {
+    std::vector<DependencyContainer> containers(meter.runs());
+    meter.measure([&](int run) {
+      auto task = producer->setup(containers[run]);
+      const auto init = task.init();
+      return init.has_value() && task.teardown().has_value();
+    });
+  };
+
+  DependencyContainer container;
+  REQUIRE(container.provide(modules::producer::Provides{}).has_value());
+
+  BENCHMARK("resolve") {
+    auto task = consumer->setup(container);
+    const auto init = task.init();
+    return init.has_value() && task.teardown().has_value();
+  };
+}
+
+}  // namespace injectx::core::benchmarks
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/static_map.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace injectx::stdext::benchmarks {
+
+template<std::size_t Size>
+void benchmarkFind() {
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < Size; ++i) {
+    keys.push_back(fmt::format("dependency-{}", i));
+  }
+
+  // too big for the stack with the larger sizes
+  using Map = static_map<std::string_view, std::size_t, Size>;
+  auto map = std::make_unique<Map>();
+  for (std::size_t i = 0; i < Size; ++i) {
+    REQUIRE(map->try_emplace(keys[i], i).has_value());
+  }
+
+  BENCHMARK(fmt::format("find all {} keys", Size)) {
+    std::size_t found{};
+    for (const auto &key : keys) {
+      found += map->find(key) != map->end();
+    }
+    return found;
+  };
+
+  BENCHMARK(fmt::format("find missing key in {}", Size)) {
+    return map->find("missing") != map->end();
+  };
+
+  const auto frozen =
+      std::make_unique<typename Map::frozen_type>(map->freeze());
+
+  BENCHMARK(fmt::format("frozen find all {} keys", Size)) {
+    std::size_t found{};
+    for (const auto &key : keys) {
+      found += frozen->find(key) != frozen->end();
+    }
+    return found;
+  };
+
+  BENCHMARK(fmt::format("frozen find missing key in {}", Size)) {
+    return frozen->find("missing") != frozen->end();
+  };
+}
+
+TEST_CASE("static-map-find") {
+  benchmarkFind<16>();
+  benchmarkFind<128>();
+  benchmarkFind<1024>();
+}
+
+}  // namespace injectx::stdext::benchmarks
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/core/setup_task.hpp"
+#include "injectx/stdext/coro/promise.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/expected.hpp"
+#include "injectx/stdext/generator.hpp"
+#include "injectx/stdext/monadics.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace injectx::core {
+
+namespace details::_async_setup_task {
+
+// T is the expected yielded by the setup
+template<typename T>
+class promise : public stdext::coro::promise_continuation {
+ public:
+  using value_type = T;
+
+  [[nodiscard]] stdext::coro::task<T, promise> get_return_object() noexcept {
+    return stdext::coro::task<T, promise>{
+        stdext::coroutine_handle<promise>::from_promise(*this)};
+  }
+
+  template<typename From = stdext::details::_generator::DefaultValueType<T>>
+    requires std::constructible_from<T, From>
+  stdext::coro::resume_continuation yield_value(From &&from) {
+    value_.emplace(std::forward<From>(from));
+    ++yields_;
+    return {};
+  }
+
+  void return_void() const noexcept {
+  }
+
+  // same as for SetupTask, init and teardown are noexcept
+  void unhandled_exception() const noexcept {
+    std::terminate();
+  }
+
+  [[nodiscard]] std::size_t yields() const noexcept {
+    return yields_;
+  }
+
+  [[nodiscard]] T take() noexcept {
+    return std::move(value_).value();
+  }
+
+ private:
+  std::optional<T> value_;
+  std::size_t yields_{0};
+};
+
+}  // namespace details::_async_setup_task
+
+// Asynchronous SetupTask: the setup could co_await any awaitable before and
+// after co_yield of Provides. init() and teardown() are awaitables which
+// resume the setup until co_yield and until the end. The task must outlive
+// an init or teardown which is still in flight.
+template<details::_setup_task::VoidOrStruct T>
+class AsyncSetupTask {
+  using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+  using Expected = stdext::expected<Value, std::string>;
+  using Task =
+      stdext::coro::task<Expected, details::_async_setup_task::promise>;
+
+ public:
+  using value_type = T;
+  using promise_type = typename Task::promise_type;
+
+  /*implicit*/ AsyncSetupTask(Task &&task) noexcept
+      : task_(std::move(task)) {
+  }
+
+  [[nodiscard]] auto init() noexcept {
+    return InitAwaiter{*this};
+  }
+
+  [[nodiscard]] auto teardown() noexcept {
+    return TeardownAwaiter{*this};
+  }
+
+ private:
+  using handle_type = stdext::coroutine_handle<promise_type>;
+
+  bool initialized_{false};
+  Task task_;
+
+  [[nodiscard]] handle_type handle() noexcept {
+    return handle_type::from_promise(task_.promise());
+  }
+
+  [[nodiscard]] bool done() const noexcept {
+    const auto ready = task_.is_ready();
+    return ready.has_value() && ready.value();
+  }
+
+  class Awaiter {
+   public:
+    explicit Awaiter(AsyncSetupTask &task) noexcept
+        : task_(task) {
+    }
+
+    auto await_suspend(stdext::coroutine_handle<> awaiting) noexcept {
+      auto handle = task_.handle();
+      return handle.promise().suspend(awaiting, handle);
+    }
+
+   protected:
+    AsyncSetupTask &task_;
+    std::optional<std::string_view> error_;
+  };
+
+  class InitAwaiter : public Awaiter {
+   public:
+    using Awaiter::Awaiter;
+
+    [[nodiscard]] bool await_ready() noexcept {
+      if (this->task_.initialized_) {
+        this->error_ = "SetupTask has been already inialized";
+        return true;
+      }
+
+      this->task_.initialized_ = true;
+      return false;
+    }
+
+    [[nodiscard]] stdext::expected<value_type, std::string>
+        await_resume() noexcept {
+      if (this->error_.has_value()) {
+        return stdext::unexpected{std::string{*this->error_}};
+      }
+
+      auto &promise = this->task_.task_.promise();
+      if (promise.yields() == 0) {
+        return stdext::unexpected{"SetupTask is missing co_yield"};
+      }
+
+      if constexpr (std::is_void_v<value_type>) {
+        return promise.take() | stdext::transform([](auto) {});
+      } else {
+        return promise.take();
+      }
+    }
+  };
+
+  class TeardownAwaiter : public Awaiter {
+   public:
+    using Awaiter::Awaiter;
+
+    [[nodiscard]] bool await_ready() noexcept {
+      if (!this->task_.initialized_) {
+        this->error_ = "SetupTask task has not been inialized yet";
+        return true;
+      }
+
+      return this->task_.done();
+    }
+
+    [[nodiscard]] stdext::expected<void, std::string> await_resume() noexcept {
+      if (this->error_.has_value()) {
+        return stdext::unexpected{std::string{*this->error_}};
+      }
+
+      auto &promise = this->task_.task_.promise();
+      if (promise.yields() > 1) {
+        const auto res = promise.take();
+        if (res.has_value() == false) {
+          return stdext::unexpected{res.error()};
+        }
+
+        return stdext::unexpected{"SetupTask co_yield twice with Provides{}"};
+      }
+
+      return {};
+    }
+  };
+};
+
+namespace details::_async_setup_task {
+
+template<typename T>
+inline constexpr bool IsAsyncSetupTask = false;
+
+template<typename T>
+inline constexpr bool IsAsyncSetupTask<AsyncSetupTask<T>> = true;
+
+}  // namespace details::_async_setup_task
+
+template<typename T>
+concept IsAsyncSetupTask =
+    details::_async_setup_task::IsAsyncSetupTask<std::remove_cvref_t<T>>;
+
+}  // namespace injectx::core
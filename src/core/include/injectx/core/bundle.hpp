@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include <injectx/core/dependency_index.hpp>
 #include <injectx/core/manifest.hpp>
 #include <injectx/core/module.hpp>
+#include <injectx/core/static_dependency_container.hpp>
 #include <injectx/stdext/expected.hpp>
 #include <injectx/stdext/monadics.hpp>
 #include <injectx/stdext/ranges/aliases.hpp>
@@ -12,7 +14,12 @@
 #include <injectx/stdext/static_format.hpp>
 #include <injectx/stdext/static_map.hpp>
 #include <injectx/stdext/static_queue.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <tuple>
+#include <vector>
 
 namespace injectx::core {
 
@@ -38,6 +45,8 @@ struct ProvidesMapSizeFn {
 
 inline constexpr ProvidesMapSizeFn providesMapSize{};
 
+// Collects all provides first and sorts them once, duplicates end up next to
+// each other and lookups are binary searches, O(P log P) in total.
 template<std::size_t MaxSize>
 struct ProvidesMapFn {
   struct Error {
@@ -46,29 +55,31 @@ struct ProvidesMapFn {
     std::size_t dependency2;
   };
 
-  using Map = stdext::static_map<DependencyInfo, std::size_t, MaxSize>;
+  using Map = stdext::frozen_static_map<DependencyInfo, std::size_t, MaxSize>;
   using Expected = stdext::expected<Map, Error>;
 
   [[nodiscard]] constexpr Expected operator()(
       const auto &manifests) const noexcept {
-    Map map;
+    typename Map::container_type entries{};
+    std::array<std::size_t, MaxSize> fields{};
 
+    std::size_t count{};
     for (const auto &[mIndex, manifest] : manifests | stdext::rv::enumerate) {
       const auto provides = manifest->provides();
       for (const auto &[pIndex, provide] : provides | stdext::rv::enumerate) {
-        const auto res = map.try_emplace(provide, mIndex);
-        if (!res.has_value()) {
-          return stdext::unexpected{Error{
-              .manifest1 = res.error().has_value() ? res.error().value()->second
-                                                   : mIndex,
-              .manifest2 = mIndex,
-              .dependency2 = pIndex,
-          }};
-        }
+        entries[count] = {provide, mIndex};
+        fields[count++] = pIndex;
       }
     }
 
-    return map;
+    return Map::make(entries)
+         | stdext::transform_error([&](const auto &e) {
+             return Error{
+                 .manifest1 = entries[e.first].second,
+                 .manifest2 = entries[e.second].second,
+                 .dependency2 = fields[e.second],
+             };
+           });
   }
 };
 
@@ -96,50 +107,152 @@ struct ProvidesMapFn {
   }
 }
 
-template<std::size_t MSize>
-struct GraphAndInDegreeFn {
+struct DependenciesSizeFn {
+  [[nodiscard]] constexpr std::size_t operator()(
+      const auto &manifests) const noexcept {
+    std::size_t size{};
+    for (const auto &manifest : manifests) {
+      size += manifest->dependencies().size();
+    }
+
+    return size;
+  }
+};
+
+inline constexpr DependenciesSizeFn dependenciesSize{};
+
+// Adjacency lists of all modules stored one after another, edges of the
+// module i are nodes[offsets[i], offsets[i + 1]).
+struct Edges {
+  gsl::span<const std::size_t> offsets;
+  gsl::span<const std::size_t> nodes;
+
+  [[nodiscard]] constexpr gsl::span<const std::size_t> operator[](
+      std::size_t index) const noexcept {
+    return nodes.subspan(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+};
+
+template<std::size_t MSize, std::size_t DSize>
+struct EdgesStorage {
+  std::array<std::size_t, MSize + 1> offsets{};
+  std::array<std::size_t, DSize> nodes{};
+
+  [[nodiscard]] constexpr Edges view() const noexcept {
+    return {.offsets = offsets, .nodes = nodes};
+  }
+
+  [[nodiscard]] constexpr std::size_t size(std::size_t index) const noexcept {
+    return offsets[index + 1] - offsets[index];
+  }
+};
+
+template<std::size_t MSize, std::size_t DSize>
+struct ModulesGraph {
+  EdgesStorage<MSize, DSize> dependencies;
+  EdgesStorage<MSize, DSize> dependents;
+};
+
+// Builds both adjacency lists in O(V + E) besides a providesMap lookup of
+// every dependency. DSize is the total number of dependencies, so a module
+// requiring several fields of the same provider gets a single edge, which
+// is tracked by the last module that has been given an edge to the provider.
+template<std::size_t MSize, std::size_t DSize>
+struct ModulesGraphFn {
   struct Error {
     std::size_t manifest;
     std::size_t dependency;
   };
 
-  using Graph = std::array<std::array<std::size_t, MSize>, MSize>;
-  using InDegree = std::array<std::size_t, MSize>;
-  using InDegreeQueue = stdext::static_queue<std::size_t, MSize>;
-  using Expected =
-      stdext::expected<std::tuple<Graph, InDegree, InDegreeQueue>, Error>;
+  using Graph = ModulesGraph<MSize, DSize>;
+  using Expected = stdext::expected<Graph, Error>;
 
   [[nodiscard]] constexpr Expected operator()(
       const auto &manifests, const auto &providesMap) const noexcept {
     Graph graph{};
-    InDegree inDegree{};
-    InDegreeQueue zeroInDegreeQueue{};
+    auto &[dependencies, dependents] = graph;
+
+    // MSize is not a module, so no provider has been seen yet
+    std::array<std::size_t, MSize> lastDependent{};
+    std::ranges::fill(lastDependent, MSize);
 
-    for (const auto &[dependent, manifest] :
-         manifests | stdext::rv::enumerate) {
-      const auto dependencies = manifest->dependencies();
+    std::size_t count{};
+    for (const auto &[module, manifest] : manifests | stdext::rv::enumerate) {
+      dependencies.offsets[module] = count;
+
+      const auto required = manifest->dependencies();
       for (const auto &[depIndex, dependency] :
-           dependencies | stdext::rv::enumerate) {
+           required | stdext::rv::enumerate) {
         const auto it = providesMap.find(dependency);
         if (it == providesMap.end()) {
           return stdext::unexpected{
-              Error{.manifest = dependent, .dependency = depIndex}};
+              Error{.manifest = module, .dependency = depIndex}};
         }
 
-        const auto [_, provider] = *it;
+        // the producer of a channel requires it as well
+        const auto provider = it->second;
+        if (provider == module) {
+          continue;
+        }
 
-        graph[provider][dependent] += 1;
-        inDegree[dependent]++;
+        if (lastDependent[provider] != module) {
+          lastDependent[provider] = module;
+          dependencies.nodes[count++] = provider;
+        }
       }
     }
+    dependencies.offsets[MSize] = count;
+
+    for (std::size_t i = 0; i < count; ++i) {
+      dependents.offsets[dependencies.nodes[i] + 1]++;
+    }
+
+    for (std::size_t module = 0; module < MSize; ++module) {
+      dependents.offsets[module + 1] += dependents.offsets[module];
+    }
 
-    for (const auto &[component, degree] : inDegree | stdext::rv::enumerate) {
-      if (degree == 0) {
-        (void)zeroInDegreeQueue.push(component);
+    auto cursors = dependents.offsets;
+    for (std::size_t module = 0; module < MSize; ++module) {
+      for (std::size_t i = dependencies.offsets[module];
+           i < dependencies.offsets[module + 1]; ++i) {
+        dependents.nodes[cursors[dependencies.nodes[i]]++] = module;
       }
     }
 
-    return std::make_tuple(graph, inDegree, zeroInDegreeQueue);
+    return graph;
+  }
+};
+
+template<std::size_t MSize, std::size_t DSize>
+struct GraphAndInDegreeFn {
+  using Graph = EdgesStorage<MSize, DSize>;
+  using InDegree = std::array<std::size_t, MSize>;
+  using InDegreeQueue = stdext::static_queue<std::size_t, MSize>;
+  using Expected = stdext::expected<
+      std::tuple<Graph, InDegree, InDegreeQueue>,
+      typename ModulesGraphFn<MSize, DSize>::Error>;
+
+  [[nodiscard]] constexpr Expected operator()(
+      const auto &manifests, const auto &providesMap) const noexcept {
+    return ModulesGraphFn<MSize, DSize>{}(manifests, providesMap)
+         | stdext::transform([](const auto &graph) {
+             InDegree inDegree{};
+             InDegreeQueue zeroInDegreeQueue{};
+
+             for (std::size_t module = 0; module < MSize; ++module) {
+               inDegree[module] = graph.dependencies.size(module);
+               if (inDegree[module] == 0) {
+                 (void)zeroInDegreeQueue.push(module);
+               }
+             }
+
+             return std::make_tuple(
+                 graph.dependents, inDegree, zeroInDegreeQueue);
+           });
   }
 };
 
@@ -150,8 +263,9 @@ struct GraphAndInDegreeFn {
     return providesMap;
   } else {
     constexpr auto manifests = getManifests();
-    constexpr auto parts =
-        GraphAndInDegreeFn<manifests.size()>{}(manifests, providesMap.value());
+    constexpr auto parts = GraphAndInDegreeFn<
+        manifests.size(), dependenciesSize(manifests)>{}(
+        manifests, providesMap.value());
     using Expected =
         typename decltype(parts)::template rebind_error<std::string_view>;
 
@@ -170,6 +284,7 @@ struct GraphAndInDegreeFn {
   }
 }
 
+// Kahn's algorithm over the dependents lists, O(V + E).
 template<std::size_t MSize>
 struct TopologicalSortFn {
   using Order = std::array<std::size_t, MSize>;
@@ -195,19 +310,13 @@ struct TopologicalSortFn {
 
       order[processedCount] = component.value();
 
-      std::size_t dependent{};
-      for (const auto depends_on : adjList[component.value()]) {
-        if (depends_on != 0) {
-          inDegree[dependent]--;
-          if (inDegree[dependent] == 0) {
-            if (const auto pushed = zeroInDegreeQueue.push(dependent);
-                !pushed.has_value()) {
-              return stdext::unexpected{pushed.error()};
-            }
+      for (const auto dependent : adjList[component.value()]) {
+        if (--inDegree[dependent] == 0) {
+          if (const auto pushed = zeroInDegreeQueue.push(dependent);
+              !pushed.has_value()) {
+            return stdext::unexpected{pushed.error()};
           }
         }
-
-        dependent++;
       }
 
       processedCount++;
@@ -227,7 +336,8 @@ struct TopologicalSortFn {
     } else {
       auto [adjList, inDegree, zeroInDegreeQueue] = graphAndInDegrees.value();
       constexpr auto manifests = getManifests();
-      return this->operator()(manifests, adjList, inDegree, zeroInDegreeQueue);
+      return this->operator()(
+          manifests, adjList.view(), inDegree, zeroInDegreeQueue);
     }
   }
 };
@@ -241,17 +351,258 @@ template<auto... setups>
   return TopologicalSortFn<sizeof...(setups)>{}(getManifests);
 }
 
+// manifests are already sorted and fully resolvable
+template<auto... setups>
+inline constexpr auto graphFor = std::invoke([] {
+  auto getManifests = []() constexpr {
+    return std::array{makeManifest<setups>()...};
+  };
+
+  constexpr auto manifests = getManifests();
+  constexpr auto providesMap = buildProvidesMap(getManifests);
+  return ModulesGraphFn<manifests.size(), dependenciesSize(manifests)>{}(
+             manifests, providesMap.value())
+      .value();
+});
+
+// Every channel has to be required by its producer and exactly one other
+// module, O(C * D) where C is the number of provided channels and D of all
+// dependencies.
+struct ChannelsFn {
+  static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+  enum class Reason : std::uint8_t { notRequired, noConsumer, twoConsumers };
+
+  struct Error {
+    Reason reason;
+    std::size_t manifest;
+    std::size_t dependency;
+    std::size_t consumer1;
+    std::size_t consumer2;
+  };
+
+  using Expected = stdext::expected<void, Error>;
+
+  [[nodiscard]] constexpr Expected operator()(
+      const auto &manifests) const noexcept {
+    for (const auto &[mIndex, manifest] : manifests | stdext::rv::enumerate) {
+      const auto provides = manifest->provides();
+      for (const auto &[pIndex, provide] : provides | stdext::rv::enumerate) {
+        if (!provide.channel) {
+          continue;
+        }
+
+        Error error{
+            .reason = Reason::notRequired,
+            .manifest = mIndex,
+            .dependency = pIndex,
+            .consumer1 = none,
+            .consumer2 = none};
+        bool required{false};
+        for (const auto &[cIndex, consumer] :
+             manifests | stdext::rv::enumerate) {
+          const auto dependencies = consumer->dependencies();
+          if (std::find(dependencies.begin(), dependencies.end(), provide)
+              == dependencies.end()) {
+            continue;
+          }
+
+          if (cIndex == mIndex) {
+            required = true;
+          } else if (error.consumer1 != none) {
+            error.reason = Reason::twoConsumers;
+            error.consumer2 = cIndex;
+            return stdext::unexpected{error};
+          } else {
+            error.consumer1 = cIndex;
+          }
+        }
+
+        if (!required) {
+          return stdext::unexpected{error};
+        }
+
+        if (error.consumer1 == none) {
+          error.reason = Reason::noConsumer;
+          return stdext::unexpected{error};
+        }
+      }
+    }
+
+    return {};
+  }
+};
+
+inline constexpr ChannelsFn checkChannels{};
+
+// manifests are already fully resolvable
+[[nodiscard]] constexpr auto buildChannels(auto getManifests) noexcept {
+  using Expected = stdext::expected<void, std::string_view>;
+
+  constexpr auto manifests = getManifests();
+  constexpr auto channels = checkChannels(manifests);
+  if constexpr (channels.has_value()) {
+    return Expected{};
+  } else {
+    constexpr auto e = channels.error();
+    constexpr auto name =
+        manifests[e.manifest]->provides()[e.dependency].name;
+    if constexpr (e.reason == ChannelsFn::Reason::notRequired) {
+      return Expected{stdext::unexpected{stdext::static_format<
+          "Channel '{}' provided by '{}' is not required by it",
+          STDEXT_AS_STATIC_STRING(name),
+          STDEXT_AS_STATIC_STRING(manifests[e.manifest]->name())>()}};
+    } else if constexpr (e.reason == ChannelsFn::Reason::noConsumer) {
+      return Expected{stdext::unexpected{stdext::static_format<
+          "Channel '{}' provided by '{}' has no consumer",
+          STDEXT_AS_STATIC_STRING(name),
+          STDEXT_AS_STATIC_STRING(manifests[e.manifest]->name())>()}};
+    } else {
+      return Expected{stdext::unexpected{stdext::static_format<
+          "Channel '{}' provided by '{}' is consumed by two modules '{}' "
+          "and '{}'",
+          STDEXT_AS_STATIC_STRING(name),
+          STDEXT_AS_STATIC_STRING(manifests[e.manifest]->name()),
+          STDEXT_AS_STATIC_STRING(manifests[e.consumer1]->name()),
+          STDEXT_AS_STATIC_STRING(manifests[e.consumer2]->name())>()}};
+    }
+  }
+}
+
+template<auto... setups>
+[[nodiscard]] constexpr auto channelsFor() noexcept {
+  return buildChannels([]() constexpr {
+    return std::array{makeManifest<setups>()...};
+  });
+}
+
+// Modules grouped by depth: a module is one level after the deepest of its
+// dependencies, so modules of the same level never depend on each other.
+template<std::size_t MSize>
+struct Levels {
+  std::array<std::size_t, MSize> levelOf{};
+  // modules of the level i are modules[offsets[i], offsets[i + 1])
+  EdgesStorage<MSize, MSize> modules;
+  std::size_t size{};
+
+  [[nodiscard]] constexpr Edges view() const noexcept {
+    return {
+        .offsets = gsl::span{modules.offsets}.subspan(0, size + 1),
+        .nodes = modules.nodes};
+  }
+};
+
+template<std::size_t MSize>
+struct LevelsFn {
+  // modules are sorted, dependencies of a module always come before it
+  [[nodiscard]] constexpr Levels<MSize> operator()(
+      Edges dependencies) const noexcept {
+    Levels<MSize> levels{};
+    auto &[levelOf, modules, size] = levels;
+
+    for (std::size_t module = 0; module < MSize; ++module) {
+      for (const auto dependency : dependencies[module]) {
+        levelOf[module] = std::max(levelOf[module], levelOf[dependency] + 1);
+      }
+
+      size = std::max(size, levelOf[module] + 1);
+      modules.offsets[levelOf[module] + 1]++;
+    }
+
+    for (std::size_t level = 0; level < MSize; ++level) {
+      modules.offsets[level + 1] += modules.offsets[level];
+    }
+
+    auto cursors = modules.offsets;
+    for (std::size_t module = 0; module < MSize; ++module) {
+      modules.nodes[cursors[levelOf[module]]++] = module;
+    }
+
+    return levels;
+  }
+};
+
+template<auto... setups>
+inline constexpr auto levelsFor = LevelsFn<sizeof...(setups)>{}(
+    graphFor<setups...>.dependencies.view());
+
+// provider of every dependency, manifests are already sorted
+template<auto... setups>
+inline constexpr auto providersFor = std::invoke([] {
+  auto getManifests = []() constexpr {
+    return std::array{makeManifest<setups>()...};
+  };
+
+  constexpr auto providesMap = buildProvidesMap(getManifests).value();
+  return details::_dependency_index::BuildFn<providesMap.size()>{}(
+             providesMap)
+      .value();
+});
+
 struct Bundle {
   gsl::span<const Module> modules;
+  Edges dependencies;
+  Edges dependents;
+  DependencyIndex providers;
+  Edges levels;
+  gsl::span<const std::size_t> levelOf;
+  gsl::span<const std::chrono::nanoseconds> remainingCosts;
+  AnyDependencyContainer (*makeDependencyContainer)();
 };
 
+template<auto... setups>
+using DependencyContainerFor =
+    StaticDependencyContainer<typename SetupTraits<setups>::Provides...>;
+
 template<auto... setups>
 inline constexpr auto modulesFor = std::invoke([] {
-  return std::array{makeModule<setups>().value()...};
+  return std::array{Module{
+      &details::_module::vtableFor<setups, DependencyContainerFor<setups...>>,
+      makeManifest<setups>().value()}...};
 });
 
+// Longest chain of costs from every module to the end of init, the module
+// included, O(V + E). Modules are sorted, so dependents of a module always
+// come after it.
+constexpr void remainingCosts(
+    Edges dependents,
+    auto costOf,
+    gsl::span<std::chrono::nanoseconds> remaining) noexcept {
+  for (std::size_t module = remaining.size(); module-- > 0;) {
+    std::chrono::nanoseconds longest{0};
+    for (const auto dependent : dependents[module]) {
+      longest = std::max(longest, remaining[dependent]);
+    }
+
+    remaining[module] = longest + costOf(module);
+  }
+}
+
 template<auto... setups>
-inline constexpr Bundle bundleFor = {.modules = modulesFor<setups...>};
+inline constexpr auto remainingCostsFor = std::invoke([] {
+  std::array<std::chrono::nanoseconds, sizeof...(setups)> remaining{};
+  remainingCosts(
+      graphFor<setups...>.dependents.view(),
+      [](std::size_t module) {
+        return modulesFor<setups...>[module].cost();
+      },
+      remaining);
+  return remaining;
+});
+
+template<auto... setups>
+inline constexpr Bundle bundleFor = {
+    .modules = modulesFor<setups...>,
+    .dependencies = graphFor<setups...>.dependencies.view(),
+    .dependents = graphFor<setups...>.dependents.view(),
+    .providers = providersFor<setups...>.view(),
+    .levels = levelsFor<setups...>.view(),
+    .levelOf = levelsFor<setups...>.levelOf,
+    .remainingCosts = remainingCostsFor<setups...>,
+    .makeDependencyContainer = [] {
+      return AnyDependencyContainer{
+          std::in_place_type<DependencyContainerFor<setups...>>};
+    }};
 
 template<auto... setups>
 [[nodiscard]] consteval auto make() noexcept {
@@ -260,6 +611,9 @@ template<auto... setups>
   constexpr auto sorted = topologicalSort<setups...>();
   if constexpr (!sorted.has_value()) {
     return Expected{stdext::unexpected{sorted.error()}};
+  } else if constexpr (constexpr auto channels = channelsFor<setups...>();
+                       !channels.has_value()) {
+    return Expected{stdext::unexpected{channels.error()}};
   } else {
     constexpr auto t = std::make_tuple(setups...);
 
@@ -300,6 +654,83 @@ class Bundle {
     return b_->modules.end();
   }
 
+  // indexes of modules which provide dependencies for the module
+  [[nodiscard]] constexpr gsl::span<const std::size_t> dependencies(
+      std::size_t index) const noexcept {
+    return b_->dependencies[index];
+  }
+
+  // indexes of modules which depend on the module
+  [[nodiscard]] constexpr gsl::span<const std::size_t> dependents(
+      std::size_t index) const noexcept {
+    return b_->dependents[index];
+  }
+
+  // number of levels, modules of the same level do not depend on each other
+  // and could be initialized in parallel once previous levels are done
+  [[nodiscard]] constexpr std::size_t levels() const noexcept {
+    return b_->levels.size();
+  }
+
+  // indexes of modules of the level
+  [[nodiscard]] constexpr gsl::span<const std::size_t> level(
+      std::size_t index) const noexcept {
+    return b_->levels[index];
+  }
+
+  [[nodiscard]] constexpr std::size_t levelOf(
+      std::size_t index) const noexcept {
+    return b_->levelOf[index];
+  }
+
+  // longest chain of setupCost from the module to the end of init, the
+  // module included
+  [[nodiscard]] constexpr std::chrono::nanoseconds remainingCost(
+      std::size_t index) const noexcept {
+    return b_->remainingCosts[index];
+  }
+
+  // Same for costs in bundle order, e.g. of a StartupProfile, modules past
+  // the end of costs use their setupCost.
+  [[nodiscard]] std::vector<std::chrono::nanoseconds> remainingCosts(
+      gsl::span<const std::chrono::nanoseconds> costs) const {
+    std::vector<std::chrono::nanoseconds> remaining(
+        b_->remainingCosts.begin(), b_->remainingCosts.end());
+    if (!costs.empty()) {
+      details::_bundle::remainingCosts(
+          b_->dependents,
+          [&](std::size_t module) {
+            return module < costs.size() ? costs[module]
+                                         : b_->modules[module].cost();
+          },
+          remaining);
+    }
+
+    return remaining;
+  }
+
+  // estimated init duration of the bundle with unlimited threads, the
+  // longest chain of setupCost
+  [[nodiscard]] constexpr std::chrono::nanoseconds criticalPath()
+      const noexcept {
+    std::chrono::nanoseconds longest{0};
+    for (const auto cost : b_->remainingCosts) {
+      longest = std::max(longest, cost);
+    }
+
+    return longest;
+  }
+
+  // index of the module which provides the dependency
+  [[nodiscard]] constexpr std::optional<std::size_t> provider(
+      const DependencyInfo &info) const noexcept {
+    return b_->providers.find(info);
+  }
+
+  [[nodiscard]] AnyDependencyContainer makeDependencyContainer() const {
+    return b_->makeDependencyContainer();
+  }
+
  private:
   const details::_bundle::Bundle *b_{nullptr};
 };
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/expects.hpp"
+#include "injectx/stdext/static_ring.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace injectx::core {
+
+// Stream of T from one module to another. The producer declares it in its
+// Provides and in its Requires and pushes into it, exactly one consumer
+// declares the same Channel<T, Capacity> in its Requires and pops from it.
+// makeBundle() rejects a channel which its producer does not require or
+// which has no or several consumers.
+//
+// The dependency container of the bundle creates the ring of every channel
+// before the first init, the producer receives it through its Requires and
+// provides it back unchanged. The consumer is a dependent of the producer,
+// so it receives the channel before its init and is torn down first.
+//
+// The producer has to co_yield its Provides before it blocks on a full
+// channel, e.g. push from a task it schedules in init. A full channel
+// suspends the producer on wait_not_full() until the consumer pops, which
+// gives back-pressure.
+template<typename T, std::size_t Capacity = 64>
+class Channel {
+ public:
+  using value_type = T;
+  using ring_type = stdext::static_ring<T, Capacity>;
+
+  // only to keep Provides and Requires aggregates default constructible,
+  // a default constructed channel has no ring
+  Channel() noexcept = default;
+
+  // a channel with a ring of its own, e.g. for the dependency container
+  [[nodiscard]] static Channel make() {
+    return Channel{std::make_shared<ring_type>()};
+  }
+
+  [[nodiscard]] ring_type &operator*() const noexcept {
+    stdext::expects(ring_ != nullptr, "Channel is not bound");
+    return *ring_;
+  }
+
+  [[nodiscard]] ring_type *operator->() const noexcept {
+    stdext::expects(ring_ != nullptr, "Channel is not bound");
+    return ring_.get();
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return ring_ != nullptr;
+  }
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept {
+    return Capacity;
+  }
+
+  // copies of the same channel share the ring
+  [[nodiscard]] friend bool operator==(
+      const Channel &, const Channel &) noexcept = default;
+
+ private:
+  std::shared_ptr<ring_type> ring_;
+
+  explicit Channel(std::shared_ptr<ring_type> ring) noexcept
+      : ring_(std::move(ring)) {
+  }
+};
+
+namespace details::_channel {
+
+template<typename T>
+inline constexpr bool IsChannel = false;
+
+template<typename T, std::size_t Capacity>
+inline constexpr bool IsChannel<Channel<T, Capacity>> = true;
+
+}  // namespace details::_channel
+
+template<typename T>
+concept IsChannel = details::_channel::IsChannel<std::remove_cvref_t<T>>;
+
+}  // namespace injectx::core
@@ -3,24 +3,139 @@
 
 #pragma once
 
+#include "injectx/core/factory.hpp"
+#include "injectx/core/ref.hpp"
 #include "injectx/stdext/expected.hpp"
-#include "injectx/stdext/monadics.hpp"
 #include "injectx/stdext/type_name.hpp"
 
 #include <boost/pfr.hpp>
-#include <fmt/ranges.h>
+#include <fmt/format.h>
 
-#include <any>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
-#include <vector>
 
 namespace injectx::core {
 
 namespace details::_dependency_container {
 
-using Storage = std::unordered_map<std::string_view, std::any>;
+inline constexpr std::size_t inlineCapacity = 3 * sizeof(void *);
+
+// small values which could be moved without throwing are stored inline
+template<typename T>
+inline constexpr bool isInline = sizeof(T) <= inlineCapacity
+                              && alignof(T) <= alignof(std::max_align_t)
+                              && std::is_nothrow_move_constructible_v<T>;
+
+// Type erased operations of a stored value, the storage holds either the
+// value itself or a pointer to it on the heap.
+struct Ops {
+  const std::type_info &type;
+  const void *(*address)(const std::byte *storage) noexcept;
+  void (*move)(std::byte *from, std::byte *to) noexcept;
+  void (*destroy)(std::byte *storage) noexcept;
+};
+
+template<typename T>
+inline constexpr Ops inlineOps = {
+    .type = typeid(T),
+    .address = [](const std::byte *storage) noexcept -> const void * {
+      return std::launder(reinterpret_cast<const T *>(storage));
+    },
+    .move =
+        [](std::byte *from, std::byte *to) noexcept {
+          auto *value = std::launder(reinterpret_cast<T *>(from));
+          ::new (static_cast<void *>(to)) T(std::move(*value));
+          value->~T();
+        },
+    .destroy =
+        [](std::byte *storage) noexcept {
+          std::launder(reinterpret_cast<T *>(storage))->~T();
+        },
+};
+
+template<typename T>
+inline constexpr Ops heapOps = {
+    .type = typeid(T),
+    .address = [](const std::byte *storage) noexcept -> const void * {
+      return *std::launder(reinterpret_cast<T *const *>(storage));
+    },
+    .move =
+        [](std::byte *from, std::byte *to) noexcept {
+          ::new (static_cast<void *>(to))
+              T *(*std::launder(reinterpret_cast<T **>(from)));
+        },
+    .destroy =
+        [](std::byte *storage) noexcept {
+          delete *std::launder(reinterpret_cast<T **>(storage));
+        },
+};
+
+// Owns a provided value of any type. Like std::any it stores small values
+// inline, unlike it it does not require the value to be copy constructible,
+// so move-only dependencies can be provided.
+class Value {
+ public:
+  template<typename T, typename Type = std::remove_cvref_t<T>>
+  explicit Value(T &&value) {
+    if constexpr (isInline<Type>) {
+      ::new (static_cast<void *>(storage_)) Type(std::forward<T>(value));
+      ops_ = &inlineOps<Type>;
+    } else {
+      ::new (static_cast<void *>(storage_))
+          Type *(new Type(std::forward<T>(value)));
+      ops_ = &heapOps<Type>;
+    }
+  }
+
+  Value(Value &&that) noexcept
+      : ops_(std::exchange(that.ops_, nullptr)) {
+    if (ops_ != nullptr) {
+      ops_->move(that.storage_, storage_);
+    }
+  }
+
+  Value(const Value &) = delete;
+  Value &operator=(const Value &) = delete;
+  Value &operator=(Value &&) = delete;
+
+  ~Value() {
+    if (ops_ != nullptr) {
+      ops_->destroy(storage_);
+    }
+  }
+
+  // type_info is compared by value, the same type could have several
+  // type_info objects across shared libraries
+  template<typename T>
+  [[nodiscard]] const T *get() const noexcept {
+    return ops_ != nullptr && ops_->type == typeid(T)
+             ? static_cast<const T *>(ops_->address(storage_))
+             : nullptr;
+  }
+
+ private:
+  alignas(std::max_align_t) std::byte storage_[inlineCapacity];
+  const Ops *ops_{nullptr};
+};
+
+struct Entry {
+  Value value;
+  bool factory;
+};
+
+using Storage = std::unordered_map<std::string_view, Entry>;
 
 template<std::size_t Idx, typename T>
 using Field = boost::pfr::tuple_element_t<Idx, T>;
@@ -30,93 +145,124 @@ using GetExpected = stdext::expected<T, std::string>;
 
 using InsertExpected = stdext::expected<void, std::string>;
 
+enum class Status : std::uint8_t { ok, missing, differentType };
+
 template<typename T>
-GetExpected<T> get(const Storage &storage, std::string_view name) noexcept {
+Status find(
+    const Storage &storage,
+    std::string_view name,
+    const Entry *&entry) noexcept {
   const auto it = storage.find(name);
   if (it == storage.end()) {
-    return stdext::unexpected{fmt::format(
-        "'{} {}' has not been provided", stdext::type_name<T>(), name)};
+    return Status::missing;
   }
 
-  if (const auto is_callable = std::any_cast<std::function<T()>>(&it->second);
-      is_callable) {
-    return std::invoke(*is_callable);
-  } else if (const auto t = std::any_cast<T>(&it->second); t) {
-    return *t;
+  entry = &it->second;
+  const auto &[value, factory] = it->second;
+  if constexpr (IsRef<T>) {
+    return value.get<RefValueType<T>>() ? Status::ok : Status::differentType;
+  } else if (factory && !IsFactory<T>) {
+    return value.get<Factory<T>>() ? Status::ok : Status::differentType;
+  } else {
+    return value.get<T>() ? Status::ok : Status::differentType;
   }
-
-  return stdext::unexpected{
-      fmt::format("'{} {}' has different type", stdext::type_name<T>(), name)};
 }
 
-template<typename T, std::size_t... Idx>
-GetExpected<T> get(
-    const Storage &storage, std::index_sequence<Idx...>) noexcept {
-  std::vector<std::string> errors;
-
-  [[maybe_unused]] std::tuple fields = {std::invoke([&] {
-    constexpr auto name = boost::pfr::get_name<Idx, T>();
-    auto field = get<Field<Idx, T>>(storage, name);
-
-    if (!field.has_value()) {
-      errors.push_back(field.error());
+template<typename T>
+T get(const Entry &entry) {
+  if constexpr (IsRef<T>) {
+    return T{*entry.value.get<RefValueType<T>>()};
+  } else {
+    if constexpr (!IsFactory<T>) {
+      if (entry.factory) {
+        return std::invoke(*entry.value.get<Factory<T>>());
+      }
     }
 
-    return field;
-  })...};
-
-  if (!errors.empty()) {
-    return stdext::unexpected{fmt::format(
-        "Dependenc{} {}", errors.size() == 1 ? "y" : "ies",
-        fmt::join(errors, ", "))};
+    static_assert(
+        std::is_copy_constructible_v<T>,
+        "Move-only dependency could be resolved only as Ref<T>");
+    return *entry.value.get<T>();
   }
+}
 
-  return T{std::get<Idx>(std::move(fields)).value()...};
+// Messages are formatted only once resolve has failed, so the success path
+// does not allocate.
+template<typename T, std::size_t Size, std::size_t... Idx>
+std::string errorOf(
+    const std::array<Status, Size> &statuses,
+    std::index_sequence<Idx...>) noexcept {
+  const auto failed = static_cast<std::size_t>(
+      std::ranges::count_if(statuses, [](auto status) {
+        return status != Status::ok;
+      }));
+
+  std::string error = failed == 1 ? "Dependency " : "Dependencies ";
+  bool first{true};
+  (std::invoke([&] {
+     if (statuses[Idx] == Status::ok) {
+       return;
+     }
+
+     fmt::format_to(
+         std::back_inserter(error), "{}'{} {}' {}", first ? "" : ", ",
+         stdext::type_name<Field<Idx, T>>(), boost::pfr::get_name<Idx, T>(),
+         statuses[Idx] == Status::missing ? "has not been provided"
+                                          : "has different type");
+     first = false;
+   }),
+   ...);
+
+  return error;
 }
 
-template<typename T>
-InsertExpected insert(
-    Storage &storage, std::string_view name, const T &value) noexcept {
-  const auto &[_, res] = storage.try_emplace(name, value);
-  if (!res) {
-    return stdext::unexpected{fmt::format(
-        "Dependency '{} {}' has been already provided", stdext::type_name<T>(),
-        name)};
-  }
+template<typename T, std::size_t... Idx>
+GetExpected<T> get(
+    const Storage &storage, std::index_sequence<Idx...> fields) noexcept {
+  // nothing to resolve, e.g. an empty Requires
+  if constexpr (sizeof...(Idx) == 0) {
+    return T{};
+  } else {
+    std::array<const Entry *, sizeof...(Idx)> entries{};
+    const std::array<Status, sizeof...(Idx)> statuses{find<Field<Idx, T>>(
+        storage, boost::pfr::get_name<Idx, T>(), entries[Idx])...};
+
+    if (((statuses[Idx] == Status::ok) && ...)) {
+      return T{get<Field<Idx, T>>(*entries[Idx])...};
+    }
 
-  return {};
+    return stdext::unexpected{errorOf<T>(statuses, fields)};
+  }
 }
 
+// All names are checked before anything is inserted, so a failed provide
+// neither changes the storage nor moves any field out of the value.
 template<typename T, std::size_t... Idx>
 InsertExpected insert(
-    Storage &storage, const T &value, std::index_sequence<Idx...>) noexcept {
-  using Expected = stdext::expected<std::string_view, std::string>;
-
-  std::vector<Expected> results;
-  const auto inserted =
-      (std::invoke([&] {
-         constexpr auto name = boost::pfr::get_name<Idx, T>();
-
-         auto res = insert(storage, name, boost::pfr::get<Idx>(value))
-                  | stdext::transform([name] {
-                      return name;
-                    });
-
-         results.push_back(std::move(res));
-         return results.back().has_value();
-       })
-       && ...);
-
-  if (!inserted) {
-    for (const auto &result : results) {
-      if (result.has_value()) {
-        storage.erase(result.value());
-      }
-    }
-
-    return stdext::unexpected{results.back().error()};
+    Storage &storage, T &&value, std::index_sequence<Idx...>) noexcept {
+  using Type = std::remove_cvref_t<T>;
+
+  std::optional<std::string> error;
+  (std::invoke([&] {
+     constexpr auto name = boost::pfr::get_name<Idx, Type>();
+     if (!error.has_value() && storage.contains(name)) {
+       error = fmt::format(
+           "Dependency '{} {}' has been already provided",
+           stdext::type_name<Field<Idx, Type>>(), name);
+     }
+   }),
+   ...);
+
+  if (error.has_value()) {
+    return stdext::unexpected{std::move(error).value()};
   }
 
+  (storage.try_emplace(
+       boost::pfr::get_name<Idx, Type>(),
+       Entry{
+           .value = Value{boost::pfr::get<Idx>(std::forward<T>(value))},
+           .factory = IsFactory<Field<Idx, Type>>}),
+   ...);
   return {};
 }
 
@@ -124,11 +270,14 @@ InsertExpected insert(
 
 class DependencyContainer {
  public:
+  // Fields of an rvalue Provides are moved into the container.
   template<typename Provides>
-  [[nodiscard]] auto provide(const Provides &provides) noexcept {
-    constexpr auto fieldsCount = boost::pfr::tuple_size_v<Provides>;
+  [[nodiscard]] auto provide(Provides &&provides) noexcept {
+    constexpr auto fieldsCount =
+        boost::pfr::tuple_size_v<std::remove_cvref_t<Provides>>;
     return details::_dependency_container::insert(
-        storage_, provides, std::make_index_sequence<fieldsCount>{});
+        storage_, std::forward<Provides>(provides),
+        std::make_index_sequence<fieldsCount>{});
   }
 
   template<typename Requires>
@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/core/dependency_info.hpp"
+#include "injectx/stdext/expected.hpp"
+
+#include <gsl/span>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace injectx::core {
+
+namespace details::_dependency_index {
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// splitmix64 finalizer
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111eb;
+  x ^= x >> 31;
+  return x;
+}
+
+[[nodiscard]] constexpr std::size_t bucketOf(
+    std::uint64_t fingerprint, std::size_t buckets) noexcept {
+  return static_cast<std::size_t>(mix(fingerprint) % buckets);
+}
+
+[[nodiscard]] constexpr std::size_t slotOf(
+    std::uint64_t fingerprint, std::size_t pilot, std::size_t slots) noexcept {
+  return static_cast<std::size_t>(
+      mix(fingerprint ^ (pilot * 0x9e3779b97f4a7c15)) % slots);
+}
+
+struct Entry {
+  DependencyInfo info;
+  std::size_t value{npos};
+};
+
+}  // namespace details::_dependency_index
+
+// Perfect hash table of dependencies built at compile time. Every dependency
+// falls into a bucket by its fingerprint, and every bucket has a pilot which
+// places its dependencies into free slots of the table. A lookup hashes the
+// fingerprint twice and compares a single entry.
+class DependencyIndex {
+  using Entry = details::_dependency_index::Entry;
+
+ public:
+  constexpr DependencyIndex() noexcept = default;
+
+  constexpr DependencyIndex(
+      gsl::span<const std::size_t> pilots,
+      gsl::span<const Entry> slots) noexcept
+      : pilots_(pilots),
+        slots_(slots) {
+  }
+
+  [[nodiscard]] constexpr std::optional<std::size_t> find(
+      const DependencyInfo &info) const noexcept {
+    namespace impl = details::_dependency_index;
+
+    if (slots_.empty()) {
+      return std::nullopt;
+    }
+
+    const auto bucket = impl::bucketOf(info.fingerprint, pilots_.size());
+    const auto slot =
+        impl::slotOf(info.fingerprint, pilots_[bucket], slots_.size());
+
+    const auto &entry = slots_[slot];
+    if (entry.value == impl::npos || !(entry.info == info)) {
+      return std::nullopt;
+    }
+
+    return entry.value;
+  }
+
+ private:
+  gsl::span<const std::size_t> pilots_;
+  gsl::span<const Entry> slots_;
+};
+
+namespace details::_dependency_index {
+
+template<std::size_t Size>
+struct Storage {
+  std::array<std::size_t, Size / 2 + 1> pilots{};
+  std::array<Entry, Size * 2 + 1> slots{};
+
+  [[nodiscard]] constexpr DependencyIndex view() const noexcept {
+    return {pilots, slots};
+  }
+};
+
+// Hash and displace: the biggest buckets are placed first, the pilot of a
+// bucket is the first one which moves all its dependencies into free slots.
+// The table is twice as big as the number of dependencies, so a pilot is
+// found after a few attempts.
+template<std::size_t Size>
+struct BuildFn {
+  using Expected = stdext::expected<Storage<Size>, std::string_view>;
+
+  // entries is a range of Size pairs of DependencyInfo and value
+  [[nodiscard]] constexpr Expected operator()(
+      const auto &entries) const noexcept {
+    Storage<Size> storage{};
+    auto &[pilots, slots] = storage;
+
+    std::array<DependencyInfo, Size> keys{};
+    std::array<std::size_t, Size> values{};
+    std::array<std::size_t, Size> buckets{};
+    std::array<std::size_t, Size / 2 + 1> bucketSizes{};
+
+    std::size_t count{};
+    for (const auto &[info, value] : entries) {
+      keys[count] = info;
+      values[count] = value;
+      buckets[count] = bucketOf(info.fingerprint, pilots.size());
+      bucketSizes[buckets[count]]++;
+      count++;
+    }
+
+    std::array<std::size_t, Size> order{};
+    for (std::size_t i = 0; i < Size; ++i) {
+      order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+      const auto lBucket = buckets[lhs];
+      const auto rBucket = buckets[rhs];
+      if (bucketSizes[lBucket] != bucketSizes[rBucket]) {
+        return bucketSizes[lBucket] > bucketSizes[rBucket];
+      }
+
+      return lBucket < rBucket;
+    });
+
+    for (std::size_t first = 0; first < Size;) {
+      const auto bucket = buckets[order[first]];
+      const auto last = first + bucketSizes[bucket];
+
+      // equal fingerprints always share a bucket and never get distinct slots
+      for (std::size_t i = first; i < last; ++i) {
+        for (std::size_t j = i + 1; j < last; ++j) {
+          if (keys[order[i]].fingerprint == keys[order[j]].fingerprint) {
+            return stdext::unexpected{
+                std::string_view{"dependency fingerprints collide"}};
+          }
+        }
+      }
+
+      for (std::size_t pilot = 0;; ++pilot) {
+        bool placed{true};
+        for (std::size_t i = first; i < last && placed; ++i) {
+          const auto slot =
+              slotOf(keys[order[i]].fingerprint, pilot, slots.size());
+          placed = slots[slot].value == npos;
+          for (std::size_t j = first; j < i && placed; ++j) {
+            placed =
+                slot != slotOf(keys[order[j]].fingerprint, pilot, slots.size());
+          }
+        }
+
+        if (placed) {
+          pilots[bucket] = pilot;
+          for (std::size_t i = first; i < last; ++i) {
+            const auto slot =
+                slotOf(keys[order[i]].fingerprint, pilot, slots.size());
+            slots[slot] = {.info = keys[order[i]], .value = values[order[i]]};
+          }
+          break;
+        }
+      }
+
+      first = last;
+    }
+
+    return storage;
+  }
+};
+
+}  // namespace details::_dependency_index
+
+}  // namespace injectx::core
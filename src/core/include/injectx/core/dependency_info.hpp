@@ -1,16 +1,67 @@
 #pragma once
 
 #include <compare>
+#include <cstdint>
 #include <string_view>
 
 namespace injectx::core {
 
+namespace details::_dependency_info {
+
+// FNV-1a over the type, a separator and the name
+[[nodiscard]] constexpr std::uint64_t fingerprint(
+    std::string_view type, std::string_view name) noexcept {
+  constexpr std::uint64_t prime = 0x100000001b3;
+  std::uint64_t hash = 0xcbf29ce484222325;
+
+  const auto add = [&](char c) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= prime;
+  };
+
+  for (const auto c : type) {
+    add(c);
+  }
+
+  add('\0');
+
+  for (const auto c : name) {
+    add(c);
+  }
+
+  return hash;
+}
+
+}  // namespace details::_dependency_info
+
 struct DependencyInfo {
   std::string_view type;
   std::string_view name;
+  std::uint64_t fingerprint =
+      details::_dependency_info::fingerprint(type, name);
+  // set for a Channel, which needs exactly one consumer, not compared
+  bool channel{false};
+
+  // fingerprints are compared first, strings only when they are equal
+  friend constexpr bool operator==(
+      const DependencyInfo &lhs, const DependencyInfo &rhs) noexcept {
+    return lhs.fingerprint == rhs.fingerprint && lhs.type == rhs.type
+        && lhs.name == rhs.name;
+  }
 
+  // ordered by fingerprint, not alphabetically
   friend constexpr std::strong_ordering operator<=>(
-      const DependencyInfo &, const DependencyInfo &) = default;
+      const DependencyInfo &lhs, const DependencyInfo &rhs) noexcept {
+    if (const auto cmp = lhs.fingerprint <=> rhs.fingerprint; cmp != 0) {
+      return cmp;
+    }
+
+    if (const auto cmp = lhs.type <=> rhs.type; cmp != 0) {
+      return cmp;
+    }
+
+    return lhs.name <=> rhs.name;
+  }
 };
 
 }  // namespace injectx::core
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/expects.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace injectx::core {
+
+template<typename T>
+class Factory;
+
+namespace details::_factory {
+
+inline constexpr std::size_t capacity = 2 * sizeof(void *);
+
+template<typename F, typename T>
+concept Storable = requires {
+  requires std::is_invocable_r_v<T, const F &>;
+  requires std::is_trivially_copyable_v<F>;
+  requires std::is_trivially_destructible_v<F>;
+  requires sizeof(F) <= capacity;
+  requires alignof(F) <= alignof(void *);
+};
+
+template<typename T>
+inline constexpr bool IsFactory = false;
+
+template<typename T>
+inline constexpr bool IsFactory<Factory<T>> = true;
+
+}  // namespace details::_factory
+
+template<typename T>
+concept IsFactory = details::_factory::IsFactory<std::remove_cvref_t<T>>;
+
+// Lazy provider of T. The callable is stored inline (a function pointer or a
+// lambda capturing a few pointers or scalars), so a Factory never allocates
+// and is trivially copyable itself.
+template<typename T>
+class Factory {
+ public:
+  using value_type = T;
+
+  // only to keep Provides aggregates default constructible
+  constexpr Factory() noexcept = default;
+
+  template<typename F>
+    requires(!IsFactory<F> && details::_factory::Storable<F, T>)
+  /*implicit*/ Factory(F f) noexcept
+      : invoke_([](const std::byte *storage) -> T {
+          const auto *f = std::launder(reinterpret_cast<const F *>(storage));
+          return std::invoke(*f);
+        }) {
+    ::new (static_cast<void *>(storage_)) F(f);
+  }
+
+  [[nodiscard]] T operator()() const {
+    stdext::expects(invoke_ != nullptr, "Factory is empty");
+    return invoke_(storage_);
+  }
+
+ private:
+  alignas(void *) std::byte storage_[details::_factory::capacity]{};
+  T (*invoke_)(const std::byte *){nullptr};
+};
+
+namespace details::_factory {
+
+template<typename T>
+struct ValueType {
+  using type = T;
+};
+
+template<typename T>
+struct ValueType<Factory<T>> {
+  using type = T;
+};
+
+}  // namespace details::_factory
+
+// Type a dependency is matched by: T for both T and Factory<T>.
+template<typename T>
+using FactoryValueType = typename details::_factory::ValueType<T>::type;
+
+}  // namespace injectx::core
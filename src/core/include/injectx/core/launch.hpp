@@ -5,9 +5,52 @@
 
 #include "injectx/core/bundle.hpp"
 #include "injectx/core/export_macro.hpp"
+#include "injectx/core/launch_observer.hpp"
+#include "injectx/core/startup_profile.hpp"
+#include "injectx/stdext/coro/frame_arena.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <gsl/span>
+
+#include <chrono>
+#include <cstddef>
 
 namespace injectx::core {
 
-INJECTX_CORE_EXPORT SetupTask<void> launch(Bundle bundle) noexcept;
+struct LaunchOptions {
+  // Number of threads used to init and teardown modules. Modules are
+  // scheduled as soon as all their dependencies (or dependents during
+  // teardown) are done, the calling thread is one of the workers.
+  std::size_t threads{1};
+
+  // Optional, when set modules are initialized and torn down by the workers
+  // of the pool instead of threads, so modules can share the pool with the
+  // work they schedule on it. init() and teardown() of the launch block, do
+  // not call them from the workers of the pool.
+  stdext::coro::thread_pool *executor{nullptr};
+
+  // Optional, the coroutine frames of the module setups come from the arena,
+  // which has to outlive the launch task. Defaults to the arena which is
+  // current on the thread calling init() of the launch, if any. Frames of
+  // the launch itself come from the arena current when launch() is called.
+  stdext::coro::frame_arena *frameArena{nullptr};
+
+  // Optional, receives init/teardown/resolve/provide timings of every module.
+  LaunchObserver *observer{nullptr};
+
+  // Optional, estimated init duration of every module in bundle order, used
+  // instead of Module::cost(). Ready modules are initialized by the longest
+  // remaining chain of costs first, so slow modules and the modules waiting
+  // for them start as early as possible. Equal chains keep bundle order.
+  gsl::span<const std::chrono::nanoseconds> costs{};
+
+  // Optional, its init durations are used as costs when costs are empty,
+  // then it records init and teardown durations of this launch. Save it
+  // after teardown to schedule the next process run.
+  StartupProfile *profile{nullptr};
+};
+
+INJECTX_CORE_EXPORT SetupTask<void> launch(
+    Bundle bundle, LaunchOptions options = {}) noexcept;
 
 }  // namespace injectx::core
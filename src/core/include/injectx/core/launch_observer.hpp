@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace injectx::core {
+
+enum class LaunchPhase {
+  init,
+  teardown,
+  resolve,
+  provide,
+};
+
+[[nodiscard]] constexpr std::string_view toString(LaunchPhase phase) noexcept {
+  switch (phase) {
+    case LaunchPhase::init:
+      return "init";
+    case LaunchPhase::teardown:
+      return "teardown";
+    case LaunchPhase::resolve:
+      return "resolve";
+    case LaunchPhase::provide:
+      return "provide";
+  }
+
+  return "unknown";
+}
+
+struct LaunchEvent {
+  using Clock = std::chrono::steady_clock;
+
+  std::string_view module;
+  LaunchPhase phase;
+  Clock::time_point start;
+  Clock::duration duration;
+  std::thread::id thread;
+};
+
+// Receives a LaunchEvent once a module finished a phase. init includes
+// resolve and provide of the same module. With LaunchOptions::threads > 1
+// onEvent is called concurrently from different threads.
+class LaunchObserver {
+ public:
+  virtual ~LaunchObserver() = default;
+
+  virtual void onEvent(const LaunchEvent &event) noexcept = 0;
+};
+
+namespace details::_launch_observer {
+
+// emits an event of a phase which started at start and finished now
+inline void notify(
+    LaunchObserver *observer,
+    std::string_view module,
+    LaunchPhase phase,
+    LaunchEvent::Clock::time_point start) noexcept {
+  if (observer == nullptr) {
+    return;
+  }
+
+  observer->onEvent({
+      .module = module,
+      .phase = phase,
+      .start = start,
+      .duration = LaunchEvent::Clock::now() - start,
+      .thread = std::this_thread::get_id(),
+  });
+}
+
+template<typename F>
+decltype(auto) observe(
+    LaunchObserver *observer,
+    std::string_view module,
+    LaunchPhase phase,
+    F &&f) {
+  if (observer == nullptr) {
+    return std::invoke(std::forward<F>(f));
+  }
+
+  const auto start = LaunchEvent::Clock::now();
+  decltype(auto) result = std::invoke(std::forward<F>(f));
+  notify(observer, module, phase, start);
+
+  return result;
+}
+
+}  // namespace details::_launch_observer
+
+}  // namespace injectx::core
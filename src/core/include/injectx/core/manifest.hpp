@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include "injectx/core/channel.hpp"
 #include "injectx/core/dependency_info.hpp"
+#include "injectx/core/factory.hpp"
+#include "injectx/core/ref.hpp"
 #include "injectx/core/setup_traits.hpp"
 #include "injectx/stdext/expected.hpp"
 #include "injectx/stdext/ranges/aliases.hpp"
@@ -68,10 +71,12 @@ constexpr auto collectDependencies() {
   return []<std::size_t... Idx>(std::index_sequence<Idx...>) {
     if constexpr (sizeof...(Idx)) {
       // std::sort(provides.begin(), provides.end());
+      // Factory<T> and Ref<T> provide and require the same dependency as T
       return std::array{DependencyInfo{
-          .type =
-              stdext::type_name<typename boost::pfr::tuple_element_t<Idx, T>>(),
-          .name = boost::pfr::get_name<Idx, T>()}...};
+          .type = stdext::type_name<FactoryValueType<
+              RefValueType<boost::pfr::tuple_element_t<Idx, T>>>>(),
+          .name = boost::pfr::get_name<Idx, T>(),
+          .channel = IsChannel<boost::pfr::tuple_element_t<Idx, T>>}...};
     } else {
       return std::array<DependencyInfo, 0>{};
     }
@@ -112,9 +117,14 @@ dontDependOnItself(const auto &manifest) noexcept {
 
   for (const auto [index, dep] :
        manifest.dependencies | stdext::rv::enumerate) {
-    // const auto it = stdext::ranges::binary_find(manifest.provides, dep);
-    if (std::binary_search(
-            manifest.provides.begin(), manifest.provides.end(), dep)) {
+    // the producer of a channel requires it to receive its ring
+    if (dep.channel) {
+      continue;
+    }
+
+    // provides are in declaration order, not sorted
+    if (std::find(manifest.provides.begin(), manifest.provides.end(), dep)
+        != manifest.provides.end()) {
       return stdext::unexpected{CircularError{.dependency = index}};
     }
   }
@@ -3,62 +3,193 @@
 
 #pragma once
 
+#include "injectx/core/async_setup_task.hpp"
 #include "injectx/core/dependency_container.hpp"
+#include "injectx/core/launch_observer.hpp"
 #include "injectx/core/manifest.hpp"
 #include "injectx/core/setup_task.hpp"
+#include "injectx/core/static_dependency_container.hpp"
+#include "injectx/stdext/coro/sync_wait.hpp"
 #include "injectx/stdext/expected.hpp"
 
+#include <chrono>
+
 namespace injectx::core {
 
 namespace details::_module {
 
 template<auto setup>
-[[nodiscard]] auto invoke(DependencyContainer *dependencyContainer) noexcept {
+inline constexpr std::string_view nameOf = std::string_view{
+    details::_manifest::nameFrom<
+        typename SetupTraits<setup>::Provides,
+        typename SetupTraits<setup>::Requires>.data()};
+
+template<auto setup, typename Container>
+[[nodiscard]] auto invoke(
+    Container *dependencyContainer, LaunchObserver *observer) noexcept {
   using STraits = SetupTraits<setup>;
 
   if constexpr (std::same_as<typename STraits::Requires, std::monostate>) {
     using Expected = stdext::expected<typename STraits::Result, std::string>;
     return Expected{setup()};
   } else {
-    return dependencyContainer->resolve<typename STraits::Requires>()
+    return details::_launch_observer::observe(
+               observer, nameOf<setup>, LaunchPhase::resolve,
+               [dependencyContainer] {
+                 return dependencyContainer
+                     ->template resolve<typename STraits::Requires>();
+               })
          | stdext::transform(setup);
   }
 }
 
-template<auto setup>
-[[nodiscard]] SetupTask<void> makeSetupTask(
-    DependencyContainer *dependencyContainer) noexcept {
-  auto setupTask = invoke<setup>(dependencyContainer);
+// Awaiter which is always ready, lets sync and async setup tasks be awaited
+// the same way.
+template<typename T>
+struct Ready {
+  T value;
+
+  [[nodiscard]] bool await_ready() const noexcept {
+    return true;
+  }
+
+  void await_suspend(stdext::coroutine_handle<>) const noexcept {
+  }
+
+  [[nodiscard]] T await_resume() noexcept {
+    return std::move(value);
+  }
+};
 
-  co_yield setupTask | stdext::and_then([](auto &task) {
-    return task.init();
-  }) | stdext::and_then([&dependencyContainer](auto &&...provides) {
+template<typename T>
+Ready(T) -> Ready<T>;
+
+[[nodiscard]] auto initOf(IsSetupTask auto &task) noexcept {
+  return Ready{task.init()};
+}
+
+[[nodiscard]] auto initOf(IsAsyncSetupTask auto &task) noexcept {
+  return task.init();
+}
+
+[[nodiscard]] auto teardownOf(IsSetupTask auto &task) noexcept {
+  return Ready{task.teardown()};
+}
+
+[[nodiscard]] auto teardownOf(IsAsyncSetupTask auto &task) noexcept {
+  return task.teardown();
+}
+
+template<auto setup, typename Container>
+[[nodiscard]] auto provide(
+    Container *dependencyContainer, LaunchObserver *observer) noexcept {
+  return [dependencyContainer, observer](auto &&...provides) {
     if constexpr (sizeof...(provides) == 0) {
       return stdext::expected<void, std::string>{};
     } else {
-      return dependencyContainer->provide(
-          std::forward<decltype(provides)>(provides)...);
+      return details::_launch_observer::observe(
+          observer, nameOf<setup>, LaunchPhase::provide, [&] {
+            return dependencyContainer->provide(
+                std::forward<decltype(provides)>(provides)...);
+          });
     }
-  }) | stdext::transform([] {
-    return std::monostate{};
-  });
+  };
+}
 
-  if (const auto res = setupTask->teardown(); !res.has_value()) {
+// Works for sync and async setups, a sync setup completes inline.
+template<auto setup, typename Container>
+[[nodiscard]] AsyncSetupTask<void> makeAsyncSetupTask(
+    Container *dependencyContainer, LaunchObserver *observer) noexcept {
+  auto setupTask = invoke<setup>(dependencyContainer, observer);
+  if (!setupTask.has_value()) {
+    co_yield stdext::unexpected{std::move(setupTask).error()};
+    co_return;
+  }
+
+  co_yield (co_await initOf(*setupTask))
+      | stdext::and_then(provide<setup>(dependencyContainer, observer))
+      | stdext::transform([] {
+          return std::monostate{};
+        });
+
+  if (const auto res = co_await teardownOf(*setupTask); !res.has_value()) {
     co_yield stdext::unexpected{res.error()};
   }
+}
+
+template<auto setup, typename Container>
+[[nodiscard]] SetupTask<void> makeSetupTask(
+    Container *dependencyContainer, LaunchObserver *observer) noexcept {
+  if constexpr (IsAsyncSetupTask<typename SetupTraits<setup>::Result>) {
+    // blocks until the async setup completes
+    auto task = makeAsyncSetupTask<setup>(dependencyContainer, observer);
+    co_yield stdext::coro::sync_wait(task.init())
+        | stdext::transform([] {
+            return std::monostate{};
+          });
+
+    if (const auto res = stdext::coro::sync_wait(task.teardown());
+        !res.has_value()) {
+      co_yield stdext::unexpected{res.error()};
+    }
+  } else {
+    auto setupTask = invoke<setup>(dependencyContainer, observer);
+
+    co_yield setupTask | stdext::and_then([](auto &task) {
+      return task.init();
+    }) | stdext::and_then(provide<setup>(dependencyContainer, observer))
+      | stdext::transform([] {
+      return std::monostate{};
+    });
+
+    if (const auto res = setupTask->teardown(); !res.has_value()) {
+      co_yield stdext::unexpected{res.error()};
+    }
+  }
 
   co_return;
 }
 
 struct vtable {
-  SetupTask<void> (*setup)(DependencyContainer &dependencyContainer);
+  SetupTask<void> (*setup)(
+      DependencyContainer &dependencyContainer, LaunchObserver *observer);
+  SetupTask<void> (*setupStatic)(
+      void *dependencyContainer, LaunchObserver *observer);
+  AsyncSetupTask<void> (*setupStaticAsync)(
+      void *dependencyContainer, LaunchObserver *observer);
+  std::chrono::nanoseconds cost;
 };
 
-template<auto setup>
+template<auto setup, typename StaticContainer = void>
 inline constexpr vtable vtableFor = {
-    .setup = [](DependencyContainer &dependencyContainer) {
-      return makeSetupTask<setup>(&dependencyContainer);
-    }};
+    .setup =
+        [](DependencyContainer &dependencyContainer,
+           LaunchObserver *observer) {
+          return makeSetupTask<setup>(&dependencyContainer, observer);
+        },
+    .setupStatic = std::invoke([] {
+      using Fn = SetupTask<void> (*)(void *, LaunchObserver *);
+      if constexpr (std::is_void_v<StaticContainer>) {
+        return Fn{nullptr};
+      } else {
+        return Fn{[](void *dependencyContainer, LaunchObserver *observer) {
+          return makeSetupTask<setup>(
+              static_cast<StaticContainer *>(dependencyContainer), observer);
+        }};
+      }
+    }),
+    .setupStaticAsync = std::invoke([] {
+      using Fn = AsyncSetupTask<void> (*)(void *, LaunchObserver *);
+      if constexpr (std::is_void_v<StaticContainer>) {
+        return Fn{nullptr};
+      } else {
+        return Fn{[](void *dependencyContainer, LaunchObserver *observer) {
+          return makeAsyncSetupTask<setup>(
+              static_cast<StaticContainer *>(dependencyContainer), observer);
+        }};
+      }
+    }),
+    .cost = setupCost<setup>};
 
 }  // namespace details::_module
 
@@ -73,14 +204,36 @@ class Module {
   }
 
   [[nodiscard]] SetupTask<void> setup(
-      DependencyContainer &dependencyContainer) const noexcept {
-    return vtable_->setup(dependencyContainer);
+      DependencyContainer &dependencyContainer,
+      LaunchObserver *observer = nullptr) const noexcept {
+    return vtable_->setup(dependencyContainer, observer);
+  }
+
+  // Only modules made by a Bundle can be set up with the bundle's container.
+  [[nodiscard]] SetupTask<void> setup(
+      AnyDependencyContainer &dependencyContainer,
+      LaunchObserver *observer = nullptr) const noexcept {
+    stdext::expects(vtable_->setupStatic != nullptr);
+    return vtable_->setupStatic(dependencyContainer.get(), observer);
+  }
+
+  // Async setups could complete on any thread, see AsyncSetupTask.
+  [[nodiscard]] AsyncSetupTask<void> setupAsync(
+      AnyDependencyContainer &dependencyContainer,
+      LaunchObserver *observer = nullptr) const noexcept {
+    stdext::expects(vtable_->setupStaticAsync != nullptr);
+    return vtable_->setupStaticAsync(dependencyContainer.get(), observer);
   }
 
   constexpr std::string_view name() const noexcept {
     return manifest_.name();
   }
 
+  // setupCost of the module setup
+  constexpr std::chrono::nanoseconds cost() const noexcept {
+    return vtable_->cost;
+  }
+
  private:
   const details::_module::vtable *vtable_{nullptr};
   Manifest manifest_{nullptr};
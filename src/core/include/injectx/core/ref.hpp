@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace injectx::core {
+
+// Requires field which is resolved by reference into the container storage
+// instead of being copied. It stays valid as long as the container.
+template<typename T>
+class Ref {
+ public:
+  using type = T;
+
+  // only to keep Requires aggregates default constructible
+  constexpr Ref() noexcept = default;
+
+  constexpr explicit Ref(const T &value) noexcept
+      : value_(std::addressof(value)) {
+  }
+
+  explicit Ref(const T &&) = delete;
+
+  [[nodiscard]] constexpr const T &get() const noexcept {
+    return *value_;
+  }
+
+  [[nodiscard]] constexpr const T &operator*() const noexcept {
+    return *value_;
+  }
+
+  [[nodiscard]] constexpr const T *operator->() const noexcept {
+    return value_;
+  }
+
+ private:
+  const T *value_{nullptr};
+};
+
+namespace details::_ref {
+
+template<typename T>
+struct ValueType {
+  using type = T;
+};
+
+template<typename T>
+struct ValueType<Ref<T>> {
+  using type = T;
+};
+
+template<typename T>
+inline constexpr bool IsRef = false;
+
+template<typename T>
+inline constexpr bool IsRef<Ref<T>> = true;
+
+}  // namespace details::_ref
+
+template<typename T>
+concept IsRef = details::_ref::IsRef<std::remove_cvref_t<T>>;
+
+// Type a dependency is matched by: T for both T and Ref<T>.
+template<typename T>
+using RefValueType = typename details::_ref::ValueType<T>::type;
+
+}  // namespace injectx::core
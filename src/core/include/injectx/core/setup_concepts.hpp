@@ -1,16 +1,35 @@
 #pragma once
 
+#include "injectx/core/async_setup_task.hpp"
 #include "injectx/core/setup_task.hpp"
 #include "injectx/stdext/function_traits.hpp"
 
+#include <boost/pfr/core.hpp>
 #include <boost/pfr/tuple_size.hpp>
 
 #include <type_traits>
+#include <utility>
 
 namespace injectx::core {
 
 namespace details::_setup_concepts {
 
+template<typename T, template<typename> typename Trait>
+inline constexpr bool AllFields =
+    []<std::size_t... Idx>(std::index_sequence<Idx...>) {
+      return (Trait<boost::pfr::tuple_element_t<Idx, T>>::value && ...);
+    }(std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+
+// Provides are moved into the container, so move-only types are allowed.
+template<typename T>
+concept ValidProvides =
+    std::is_void_v<T> || AllFields<T, std::is_move_constructible>;
+
+// Requires are copied out of the container, move-only dependencies have to be
+// required as Ref<T>.
+template<typename T>
+concept ValidRequires = AllFields<T, std::is_copy_constructible>;
+
 template<typename T, std::size_t Args>
 concept ZeroArgsAndNoneVoid = requires {
   requires(Args == 0);
@@ -20,8 +39,9 @@ concept ZeroArgsAndNoneVoid = requires {
 
 template<typename T, std::size_t Args>
 concept ValidReturnType = requires {
-  requires IsSetupTask<T>;
+  requires IsSetupTask<T> || IsAsyncSetupTask<T>;
   requires(ZeroArgsAndNoneVoid<T, Args> || Args == 1);
+  requires ValidProvides<typename T::value_type>;
 };
 
 template<typename FTraits>
@@ -29,6 +49,7 @@ concept ValidFirstArg = requires {
   requires FTraits::args_count == 1;
   requires std::is_class_v<typename FTraits::template arg<0>>;
   typename boost::pfr::tuple_size<typename FTraits::template arg<0>>;
+  requires ValidRequires<typename FTraits::template arg<0>>;
 };
 
 template<typename FTraits>
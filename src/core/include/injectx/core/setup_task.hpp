@@ -9,6 +9,7 @@
 
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace injectx::core {
@@ -46,9 +47,9 @@ class SetupTask {
     }
 
     if constexpr (std::is_void_v<value_type>) {
-      return (*it) | stdext::transform([](auto) {});
+      return std::move(*it) | stdext::transform([](auto) {});
     } else {
-      return *it;
+      return std::move(*it);
     }
   }
 
@@ -58,9 +59,8 @@ class SetupTask {
     }
 
     if (auto it = generator_.begin(); it != generator_.end()) {
-      const auto res = (*it);
-      if (res.has_value() == false) {
-        return stdext::unexpected{res.error()};
+      if (auto &res = *it; res.has_value() == false) {
+        return stdext::unexpected{std::move(res).error()};
       }
 
       return stdext::unexpected{"SetupTask co_yield twice with Provides{}"};
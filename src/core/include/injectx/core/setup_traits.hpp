@@ -3,6 +3,7 @@
 #include "injectx/core/setup_concepts.hpp"
 #include "injectx/stdext/function_traits.hpp"
 
+#include <chrono>
 #include <type_traits>
 
 namespace injectx::core {
@@ -22,4 +23,12 @@ class SetupTraits {
   using Requires = typename Traits::template arg_or<0, std::monostate>;
 };
 
+// Estimated init duration of a module, used by launch to start modules on
+// the longest chain first. Specialize it for slow setups:
+//   template<>
+//   inline constexpr std::chrono::nanoseconds
+//       injectx::core::setupCost<modules::cache::setup> = 500ms;
+template<IsSetupFunction auto setup>
+inline constexpr std::chrono::nanoseconds setupCost{0};
+
 }  // namespace injectx::core
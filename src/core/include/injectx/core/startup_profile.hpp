@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/core/bundle.hpp"
+#include "injectx/core/export_macro.hpp"
+#include "injectx/core/launch_observer.hpp"
+#include "injectx/stdext/expected.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace injectx::core {
+
+// Init and teardown durations of every module of a launch, which can be
+// saved into a compact binary file and loaded by the next process run.
+// Passed as LaunchOptions::profile, its init durations are used as costs
+// of modules and then replaced by durations of the current launch.
+class INJECTX_CORE_EXPORT StartupProfile final : public LaunchObserver {
+ public:
+  struct Timings {
+    std::chrono::nanoseconds init{0};
+    std::chrono::nanoseconds teardown{0};
+
+    friend bool operator==(const Timings &, const Timings &) = default;
+  };
+
+  struct Regression {
+    std::string module;
+    LaunchPhase phase;
+    std::chrono::nanoseconds baseline;
+    std::chrono::nanoseconds current;
+  };
+
+  StartupProfile() noexcept = default;
+  StartupProfile(const StartupProfile &other);
+  StartupProfile(StartupProfile &&other) noexcept;
+  StartupProfile &operator=(const StartupProfile &other);
+  StartupProfile &operator=(StartupProfile &&other) noexcept;
+
+  // records init and teardown events, other phases are ignored
+  void onEvent(const LaunchEvent &event) noexcept override;
+
+  void set(std::string_view module, Timings timings);
+
+  [[nodiscard]] std::optional<Timings> find(std::string_view module) const;
+
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  // init duration of every module in bundle order, Module::cost() for
+  // modules which are not in the profile
+  [[nodiscard]] std::vector<std::chrono::nanoseconds> costs(
+      Bundle bundle) const;
+
+  // modules which are at least factor times slower than in baseline,
+  // phases shorter than threshold in both profiles are skipped as noise
+  [[nodiscard]] std::vector<Regression> regressions(
+      const StartupProfile &baseline,
+      double factor = 2.0,
+      std::chrono::nanoseconds threshold = std::chrono::milliseconds{1}) const;
+
+  [[nodiscard]] std::string serialize() const;
+
+  [[nodiscard]] static stdext::expected<StartupProfile, std::string>
+      deserialize(std::string_view data);
+
+  [[nodiscard]] stdext::expected<void, std::string> save(
+      const std::filesystem::path &path) const;
+
+  [[nodiscard]] static stdext::expected<StartupProfile, std::string> load(
+      const std::filesystem::path &path);
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, Timings, std::less<>> timings_;
+};
+
+}  // namespace injectx::core
@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/core/channel.hpp"
+#include "injectx/core/dependency_info.hpp"
+#include "injectx/core/factory.hpp"
+#include "injectx/core/ref.hpp"
+#include "injectx/core/manifest.hpp"
+#include "injectx/stdext/expected.hpp"
+#include "injectx/stdext/type_name.hpp"
+
+#include <boost/pfr.hpp>
+#include <fmt/ranges.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace injectx::core {
+
+namespace details::_static_dependency_container {
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+template<typename T, std::size_t... Idx>
+auto slotsOf(std::index_sequence<Idx...>)
+    -> std::tuple<std::optional<boost::pfr::tuple_element_t<Idx, T>>...>;
+
+template<typename T>
+using Slots = decltype(slotsOf<T>(
+    std::make_index_sequence<boost::pfr::tuple_size_v<T>>{}));
+
+template<typename... Provides>
+using Storage =
+    decltype(std::tuple_cat(std::declval<Slots<Provides>>()...));
+
+template<typename... Provides>
+[[nodiscard]] consteval auto collectSlots() noexcept {
+  constexpr auto size = (boost::pfr::tuple_size_v<Provides> + ... + 0);
+  std::array<DependencyInfo, size> slots{};
+
+  std::size_t slot{};
+  (std::invoke([&] {
+     for (const auto &info :
+          details::_manifest::collectDependenciesFrom<Provides>) {
+       slots[slot++] = info;
+     }
+   }),
+   ...);
+
+  return slots;
+}
+
+template<typename... Provides>
+inline constexpr auto slotsFor = collectSlots<Provides...>();
+
+template<typename T, typename... Provides>
+[[nodiscard]] consteval std::size_t offsetOf() noexcept {
+  std::size_t offset{};
+  bool found{false};
+
+  (std::invoke([&] {
+     if (found) {
+       return;
+     }
+
+     if (std::is_same_v<T, Provides>) {
+       found = true;
+     } else {
+       offset += boost::pfr::tuple_size_v<Provides>;
+     }
+   }),
+   ...);
+
+  return found ? offset : npos;
+}
+
+template<typename... Provides>
+[[nodiscard]] consteval std::size_t slotOf(DependencyInfo info) noexcept {
+  for (std::size_t slot = 0; slot < slotsFor<Provides...>.size(); ++slot) {
+    if (slotsFor<Provides...>[slot] == info) {
+      return slot;
+    }
+  }
+
+  return npos;
+}
+
+}  // namespace details::_static_dependency_container
+
+// Dependency container specialized for a fixed set of Provides structs.
+// Every provided field gets its own slot, which index is computed at compile
+// time from DependencyInfo, so provide/resolve are plain tuple accesses.
+// Channel slots are filled with a new ring up front, so the producer could
+// require its channel, and it has to provide back the same one.
+template<typename... Provides>
+class StaticDependencyContainer {
+  using Storage = details::_static_dependency_container::Storage<Provides...>;
+
+  template<std::size_t Idx, typename T>
+  using Field = boost::pfr::tuple_element_t<Idx, T>;
+
+ public:
+  StaticDependencyContainer() {
+    makeChannels(std::make_index_sequence<std::tuple_size_v<Storage>>{});
+  }
+
+  // Fields of an rvalue Provides are moved into the container.
+  template<typename T>
+  [[nodiscard]] stdext::expected<void, std::string> provide(
+      T &&provides) noexcept {
+    namespace impl = details::_static_dependency_container;
+    using Type = std::remove_cvref_t<T>;
+
+    constexpr auto offset = impl::offsetOf<Type, Provides...>();
+    static_assert(offset != impl::npos, "Provides is not part of container");
+
+    return provide<offset>(
+        std::forward<T>(provides),
+        std::make_index_sequence<boost::pfr::tuple_size_v<Type>>{});
+  }
+
+  template<typename Requires>
+  [[nodiscard]] stdext::expected<Requires, std::string> resolve()
+      const noexcept {
+    return resolve<Requires>(
+        std::make_index_sequence<boost::pfr::tuple_size_v<Requires>>{});
+  }
+
+ private:
+  Storage storage_;
+
+  template<typename Requires, std::size_t Idx>
+  static constexpr std::size_t slotOf = details::_static_dependency_container::
+      slotOf<Provides...>(
+          details::_manifest::collectDependenciesFrom<Requires>[Idx]);
+
+  template<std::size_t... Slot>
+  void makeChannels(std::index_sequence<Slot...>) {
+    (std::invoke([this] {
+       using Type =
+           typename std::tuple_element_t<Slot, Storage>::value_type;
+       if constexpr (IsChannel<Type>) {
+         std::get<Slot>(storage_).emplace(Type::make());
+       }
+     }),
+     ...);
+  }
+
+  template<std::size_t Offset, typename T, std::size_t... Idx>
+  [[nodiscard]] stdext::expected<void, std::string> provide(
+      T &&provides, std::index_sequence<Idx...>) noexcept {
+    using Type = std::remove_cvref_t<T>;
+
+    std::optional<std::string> error;
+    (std::invoke([&] {
+       const auto &slot = std::get<Offset + Idx>(storage_);
+       if (error.has_value()) {
+         return;
+       }
+
+       if constexpr (IsChannel<Field<Idx, Type>>) {
+         if (*slot != boost::pfr::get<Idx>(provides)) {
+           error = fmt::format(
+               "Channel '{} {}' is not the one from Requires",
+               stdext::type_name<Field<Idx, Type>>(),
+               boost::pfr::get_name<Idx, Type>());
+         }
+       } else if (slot.has_value()) {
+         error = fmt::format(
+             "Dependency '{} {}' has been already provided",
+             stdext::type_name<Field<Idx, Type>>(),
+             boost::pfr::get_name<Idx, Type>());
+       }
+     }),
+     ...);
+
+    if (error.has_value()) {
+      return stdext::unexpected{std::move(error).value()};
+    }
+
+    // a channel slot already holds the same ring
+    (std::invoke([&] {
+       if constexpr (!IsChannel<Field<Idx, Type>>) {
+         std::get<Offset + Idx>(storage_).emplace(
+             boost::pfr::get<Idx>(std::forward<T>(provides)));
+       }
+     }),
+     ...);
+    return {};
+  }
+
+  template<typename Requires, std::size_t Idx>
+  [[nodiscard]] bool has() const noexcept {
+    constexpr auto slot = slotOf<Requires, Idx>;
+    if constexpr (slot == details::_static_dependency_container::npos) {
+      return false;
+    } else {
+      return std::get<slot>(storage_).has_value();
+    }
+  }
+
+  template<typename Requires, std::size_t Idx>
+  [[nodiscard]] Field<Idx, Requires> get() const {
+    using Type = Field<Idx, Requires>;
+    const auto &slot = *std::get<slotOf<Requires, Idx>>(storage_);
+
+    if constexpr (IsRef<Type>) {
+      static_assert(
+          std::is_same_v<
+              RefValueType<Type>, std::remove_cvref_t<decltype(slot)>>,
+          "Factory<T> could not be resolved as Ref<T>");
+      return Type{slot};
+    } else if constexpr (IsFactory<decltype(slot)> && !IsFactory<Type>) {
+      return std::invoke(slot);
+    } else {
+      static_assert(
+          std::is_same_v<Type, std::remove_cvref_t<decltype(slot)>>,
+          "Factory<T> could be resolved only as T or Factory<T>");
+      static_assert(
+          std::is_copy_constructible_v<Type>,
+          "Move-only dependency could be resolved only as Ref<T>");
+      return slot;
+    }
+  }
+
+  template<typename Requires, std::size_t... Idx>
+  [[nodiscard]] stdext::expected<Requires, std::string> resolve(
+      std::index_sequence<Idx...>) const noexcept {
+    constexpr bool allSlots =
+        ((slotOf<Requires, Idx> != details::_static_dependency_container::npos)
+         && ...);
+
+    if constexpr (allSlots) {
+      if ((std::get<slotOf<Requires, Idx>>(storage_).has_value() && ...)) {
+        return Requires{get<Requires, Idx>()...};
+      }
+    }
+
+    std::vector<std::string> errors;
+    (std::invoke([&] {
+       if (!has<Requires, Idx>()) {
+         errors.push_back(fmt::format(
+             "'{} {}' has not been provided",
+             stdext::type_name<Field<Idx, Requires>>(),
+             boost::pfr::get_name<Idx, Requires>()));
+       }
+     }),
+     ...);
+
+    return stdext::unexpected{fmt::format(
+        "Dependenc{} {}", errors.size() == 1 ? "y" : "ies",
+        fmt::join(errors, ", "))};
+  }
+};
+
+// Owns a StaticDependencyContainer without exposing its type, so it can be
+// created by a Bundle and passed through non-template code like launch.
+class AnyDependencyContainer {
+ public:
+  template<typename Container>
+  explicit AnyDependencyContainer(std::in_place_type_t<Container>)
+      : container_(new Container{}, [](void *container) {
+          delete static_cast<Container *>(container);
+        }) {
+  }
+
+  [[nodiscard]] void *get() const noexcept {
+    return container_.get();
+  }
+
+ private:
+  std::unique_ptr<void, void (*)(void *)> container_;
+};
+
+}  // namespace injectx::core
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/core/export_macro.hpp"
+#include "injectx/core/launch_observer.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace injectx::core {
+
+// Collects every LaunchEvent and exports them in the Chrome trace event
+// format, which can be loaded in chrome://tracing or Perfetto.
+class INJECTX_CORE_EXPORT TraceEventObserver final : public LaunchObserver {
+ public:
+  TraceEventObserver() noexcept;
+
+  void onEvent(const LaunchEvent &event) noexcept override;
+
+  [[nodiscard]] std::vector<LaunchEvent> events() const;
+
+  [[nodiscard]] std::string toJson() const;
+
+ private:
+  LaunchEvent::Clock::time_point origin_;
+  mutable std::mutex mutex_;
+  std::vector<LaunchEvent> events_;
+};
+
+}  // namespace injectx::core
@@ -3,36 +3,454 @@
 
 #include "injectx/core/launch.hpp"
 
-#include <fmt/core.h>
+#include "injectx/stdext/coro/awaitable_traits.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+#include "injectx/stdext/coroutine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace injectx::core {
 
-SetupTask<void> launch(Bundle bundle) noexcept {
-  fmt::println("launch - 1");
-  DependencyContainer dependencyContainer;
-  std::vector<SetupTask<void>> setupTasks;
-  setupTasks.reserve(bundle.size());
+namespace {
+
+using Expected = stdext::expected<void, std::string>;
+
+// Number of detached coroutines of a launch which have not returned yet.
+class InFlight {
+ public:
+  void add() noexcept {
+    const std::lock_guard lock{mutex_};
+    ++count_;
+  }
+
+  void done() noexcept {
+    // notified under the lock, wait() could return as soon as it is released
+    const std::lock_guard lock{mutex_};
+    if (--count_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  void wait() noexcept {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] {
+      return count_ == 0;
+    });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t count_{0};
+};
+
+// Detached coroutine of spawnTracked(), it destroys its frame and only then
+// leaves the InFlight. The frame comes from the global operator new, never
+// from a frame_arena.
+class Tracked {
+ public:
+  class promise_type {
+   public:
+    template<typename... Args>
+    explicit promise_type(InFlight &inFlight, const Args &...) noexcept
+        : inFlight_(&inFlight) {
+      inFlight.add();
+    }
+
+    Tracked get_return_object() const noexcept {
+      return {};
+    }
+
+    stdext::suspend_never initial_suspend() const noexcept {
+      return {};
+    }
+
+    auto final_suspend() const noexcept {
+      struct Release {
+        bool await_ready() const noexcept {
+          return false;
+        }
+
+        void await_suspend(
+            stdext::coroutine_handle<promise_type> handle) const noexcept {
+          auto *inFlight = handle.promise().inFlight_;
+          handle.destroy();
+          inFlight->done();
+        }
+
+        void await_resume() const noexcept {
+        }
+      };
+
+      return Release{};
+    }
+
+    void return_void() const noexcept {
+    }
+
+    void unhandled_exception() const noexcept {
+      std::terminate();
+    }
+
+   private:
+    InFlight *inFlight_;
+  };
+};
+
+// Like stdext::coro::spawn(), but the awaiter and the callback are destroyed
+// before inFlight hears of it, so once inFlight.wait() returns nothing which
+// they refer to is touched any more.
+template<typename Awaitable, typename Callback>
+Tracked spawnTracked(
+    [[maybe_unused]] InFlight &inFlight,  // taken by the promise
+    Awaitable awaitable,
+    Callback callback) {
+  if constexpr (std::is_void_v<stdext::coro::await_result_t<Awaitable>>) {
+    co_await std::move(awaitable);
+    callback();
+  } else {
+    callback(co_await std::move(awaitable));
+  }
+}
+
+// Runs step for every module after all of its blockers have completed,
+// spreading ready modules over the threads. Ready modules are picked in the
+// order defined by Compare, the one it orders last is picked first.
+// A step reports its result through the Completion, either before it returns
+// or later from any thread, so a suspended module does not hold a worker.
+// With stopOnError no more modules are stepped after the first failure,
+// otherwise the first error is reported once every module has completed.
+// Steps spawn their coroutines with spawnTracked() on the InFlight of run(),
+// which returns only after every one of them has returned.
+template<typename Compare>
+class Dataflow {
+ public:
+  using Blockers = gsl::span<const std::size_t> (Bundle::*)(std::size_t)
+      const noexcept;
+
+  Dataflow(
+      Bundle bundle,
+      Blockers blockers,
+      Blockers unblocks,
+      bool stopOnError,
+      Compare compare = {}) noexcept
+      : bundle_(bundle),
+        unblocks_(unblocks),
+        stopOnError_(stopOnError),
+        compare_(std::move(compare)),
+        pending_(bundle.size()),
+        remaining_(bundle.size()) {
+    for (std::size_t module = 0; module < bundle.size(); ++module) {
+      pending_[module] = (bundle.*blockers)(module).size();
+      if (pending_[module] == 0) {
+        push(module);
+      }
+    }
+  }
+
+  class Completion {
+   public:
+    Completion(Dataflow &dataflow, std::size_t module) noexcept
+        : dataflow_(&dataflow),
+          module_(module) {
+    }
+
+    // must be called exactly once
+    void operator()(Expected res) const noexcept {
+      dataflow_->complete(module_, std::move(res));
+    }
+
+   private:
+    Dataflow *dataflow_;
+    std::size_t module_;
+  };
+
+  using Step = std::function<void(std::size_t, Completion)>;
+
+  Expected run(
+      std::size_t threads,
+      stdext::coro::thread_pool *executor,
+      InFlight &inFlight,
+      const Step &step) noexcept {
+    if (executor != nullptr) {
+      std::unique_lock lock{mutex_};
+      executor_ = executor;
+      inFlight_ = &inFlight;
+      step_ = &step;
+      for (std::size_t i = 0; i < ready_.size(); ++i) {
+        dispatch();
+      }
+
+      cv_.wait(lock, [this] {
+        return finished() && dispatched_ == 0;
+      });
+    } else {
+      std::vector<std::thread> workers;
+      threads = std::max<std::size_t>(1, std::min(threads, bundle_.size()));
+      workers.reserve(threads - 1);
+      for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back([this, &step] {
+          work(step);
+        });
+      }
+
+      work(step);
+      for (auto &worker : workers) {
+        worker.join();
+      }
+    }
+
+    // a completion could still be returning from its coroutine
+    inFlight.wait();
+
+    if (error_.has_value()) {
+      return stdext::unexpected{std::move(error_).value()};
+    }
+
+    return {};
+  }
+
+ private:
+  Bundle bundle_;
+  Blockers unblocks_;
+  bool stopOnError_;
+  Compare compare_;
+  std::vector<std::size_t> pending_;
+  std::vector<std::size_t> ready_;
+  std::size_t remaining_;
+  std::size_t running_{0};
+  std::optional<std::string> error_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  stdext::coro::thread_pool *executor_{nullptr};
+  InFlight *inFlight_{nullptr};
+  const Step *step_{nullptr};
+  std::size_t dispatched_{0};
+
+  void push(std::size_t module) {
+    ready_.push_back(module);
+    std::push_heap(ready_.begin(), ready_.end(), compare_);
+  }
+
+  std::size_t pop() {
+    std::pop_heap(ready_.begin(), ready_.end(), compare_);
+    const auto module = ready_.back();
+    ready_.pop_back();
+    return module;
+  }
+
+  [[nodiscard]] bool stopped() const noexcept {
+    return stopOnError_ && error_.has_value();
+  }
+
+  [[nodiscard]] bool finished() const noexcept {
+    return remaining_ == 0 || (stopped() && running_ == 0);
+  }
+
+  void work(const Step &step) {
+    std::unique_lock lock{mutex_};
+    while (true) {
+      cv_.wait(lock, [this] {
+        return finished() || (!stopped() && !ready_.empty());
+      });
+
+      if (finished()) {
+        break;
+      }
+
+      const auto module = pop();
+      ++running_;
+      lock.unlock();
+      step(module, Completion{*this, module});
+      lock.lock();
+    }
+
+    cv_.notify_all();
+  }
+
+  // With an executor every ready module gets a job on the pool, which steps
+  // the best ready module at the time it runs. Called under the lock.
+  void dispatch() {
+    ++dispatched_;
+    spawnTracked(*inFlight_, executor_->schedule(), [this] {
+      std::unique_lock lock{mutex_};
+      --dispatched_;
+      if (stopped() || ready_.empty()) {
+        cv_.notify_all();
+        return;
+      }
+
+      const auto module = pop();
+      ++running_;
+      lock.unlock();
+      (*step_)(module, Completion{*this, module});
+    });
+  }
+
+  void complete(std::size_t module, Expected res) noexcept {
+    // notified under the lock, run() could return as soon as it is released
+    const std::lock_guard lock{mutex_};
+    --running_;
+    --remaining_;
+
+    if (!res.has_value() && !error_.has_value()) {
+      error_ = std::move(res).error();
+    }
+
+    if (res.has_value() || !stopOnError_) {
+      for (const auto unblocked : (bundle_.*unblocks_)(module)) {
+        if (--pending_[unblocked] == 0) {
+          push(unblocked);
+          if (executor_ != nullptr) {
+            dispatch();
+          }
+        }
+      }
+    }
+
+    cv_.notify_all();
+  }
+};
+
+// Orders modules by the longest chain of costs from the module to the end of
+// init, ties by bundle order.
+class ByRemainingPath {
+ public:
+  ByRemainingPath(
+      Bundle bundle, gsl::span<const std::chrono::nanoseconds> costs)
+      : remaining_(bundle.remainingCosts(costs)) {
+  }
 
-  for (const auto &module : bundle) {
-    auto setupTask = module.setup(dependencyContainer);
-    if (const auto res = setupTask.init(); !res.has_value()) {
-      co_yield stdext::unexpected{res.error()};
+  [[nodiscard]] bool operator()(std::size_t lhs, std::size_t rhs)
+      const noexcept {
+    if (remaining_[lhs] != remaining_[rhs]) {
+      return remaining_[lhs] < remaining_[rhs];
     }
 
-    setupTasks.push_back(std::move(setupTask));
+    return lhs > rhs;
   }
 
-  fmt::println("launch - 2");
-  co_yield {};
-  fmt::println("launch - 3");
+ private:
+  std::vector<std::chrono::nanoseconds> remaining_;
+};
 
-  for (auto &setupTask : setupTasks) {
-    if (const auto res = setupTask.teardown(); !res.has_value()) {
-      co_yield stdext::unexpected{res.error()};
+// Forwards events to the observer and the profile of LaunchOptions.
+class Observers final : public LaunchObserver {
+ public:
+  Observers(LaunchObserver *observer, StartupProfile *profile) noexcept
+      : observer_(observer),
+        profile_(profile) {
+  }
+
+  void onEvent(const LaunchEvent &event) noexcept override {
+    if (observer_ != nullptr) {
+      observer_->onEvent(event);
+    }
+
+    if (profile_ != nullptr) {
+      profile_->onEvent(event);
     }
   }
 
-  fmt::println("launch - 4");
+ private:
+  LaunchObserver *observer_;
+  StartupProfile *profile_;
+};
+
+}  // namespace
+
+SetupTask<void> launch(Bundle bundle, LaunchOptions options) noexcept {
+  std::vector<std::chrono::nanoseconds> profileCosts;
+  if (options.costs.empty() && options.profile != nullptr) {
+    profileCosts = options.profile->costs(bundle);
+    options.costs = profileCosts;
+  }
+
+  Observers observers{options.observer, options.profile};
+  if (options.profile != nullptr) {
+    options.observer = &observers;
+  }
+
+  if (options.frameArena == nullptr) {
+    options.frameArena = stdext::coro::frame_arena::current();
+  }
+
+  auto dependencyContainer = bundle.makeDependencyContainer();
+  InFlight inFlight;
+
+  // Tasks stay alive until the end of the launch, teardown resumes them.
+  struct State {
+    std::optional<AsyncSetupTask<void>> task;
+    bool initialized{false};
+  };
+
+  std::vector<State> states(bundle.size());
+
+  const auto init = [&](std::size_t index, auto complete) {
+    const stdext::coro::frame_arena::scope arena{options.frameArena};
+    const auto start = LaunchEvent::Clock::now();
+    auto &task = states[index].task.emplace(
+        bundle[index].setupAsync(dependencyContainer, options.observer));
+    spawnTracked(
+        inFlight, task.init(), [&, index, start, complete](Expected res) {
+          details::_launch_observer::notify(
+              options.observer, bundle[index].name(), LaunchPhase::init,
+              start);
+          states[index].initialized = res.has_value();
+          complete(std::move(res));
+        });
+  };
+
+  const auto initialized =
+      Dataflow<ByRemainingPath>{
+          bundle, &Bundle::dependencies, &Bundle::dependents, true,
+          ByRemainingPath{bundle, options.costs}}
+          .run(options.threads, options.executor, inFlight, init);
+
+  if (initialized.has_value()) {
+    co_yield {};
+  } else {
+    co_yield stdext::unexpected{initialized.error()};
+  }
+
+  const auto teardown = [&](std::size_t index, auto complete) {
+    auto &state = states[index];
+    if (!state.initialized) {
+      complete({});
+      return;
+    }
+
+    const stdext::coro::frame_arena::scope arena{options.frameArena};
+    const auto start = LaunchEvent::Clock::now();
+    spawnTracked(
+        inFlight, state.task->teardown(),
+        [&, index, start, complete](Expected res) {
+          details::_launch_observer::notify(
+              options.observer, bundle[index].name(), LaunchPhase::teardown,
+              start);
+          complete(std::move(res));
+        });
+  };
+
+  const auto tornDown =
+      Dataflow<std::less<>>{
+          bundle, &Bundle::dependents, &Bundle::dependencies, false}
+          .run(options.threads, options.executor, inFlight, teardown);
+
+  if (!tornDown.has_value()) {
+    co_yield stdext::unexpected{tornDown.error()};
+  }
+
   co_return;
 }
 
@@ -0,0 +1,287 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/startup_profile.hpp"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace injectx::core {
+
+namespace {
+
+// "IXSP", version, number of modules, then for every module its name
+// size, name, init and teardown nanoseconds. Integers are little endian.
+constexpr std::string_view magic{"IXSP"};
+constexpr std::uint8_t version{1};
+
+template<typename T>
+void write(std::string &out, T value) {
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out += static_cast<char>(
+        (static_cast<std::uint64_t>(value) >> (i * 8)) & 0xff);
+  }
+}
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) noexcept
+      : data_(data) {
+  }
+
+  template<typename T>
+  [[nodiscard]] std::optional<T> read() noexcept {
+    if (data_.size() < sizeof(T)) {
+      return std::nullopt;
+    }
+
+    std::uint64_t value{};
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data_[i]))
+            << (i * 8);
+    }
+
+    data_.remove_prefix(sizeof(T));
+    return static_cast<T>(value);
+  }
+
+  [[nodiscard]] std::optional<std::string_view> read(
+      std::size_t size) noexcept {
+    if (data_.size() < size) {
+      return std::nullopt;
+    }
+
+    const auto bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return bytes;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return data_.empty();
+  }
+
+ private:
+  std::string_view data_;
+};
+
+}  // namespace
+
+StartupProfile::StartupProfile(const StartupProfile &other) {
+  const std::lock_guard lock{other.mutex_};
+  timings_ = other.timings_;
+}
+
+StartupProfile::StartupProfile(StartupProfile &&other) noexcept {
+  const std::lock_guard lock{other.mutex_};
+  timings_ = std::move(other.timings_);
+}
+
+StartupProfile &StartupProfile::operator=(const StartupProfile &other) {
+  if (this != &other) {
+    const std::scoped_lock lock{mutex_, other.mutex_};
+    timings_ = other.timings_;
+  }
+
+  return *this;
+}
+
+StartupProfile &StartupProfile::operator=(StartupProfile &&other) noexcept {
+  if (this != &other) {
+    const std::scoped_lock lock{mutex_, other.mutex_};
+    timings_ = std::move(other.timings_);
+  }
+
+  return *this;
+}
+
+void StartupProfile::onEvent(const LaunchEvent &event) noexcept {
+  if (event.phase != LaunchPhase::init
+      && event.phase != LaunchPhase::teardown) {
+    return;
+  }
+
+  const std::lock_guard lock{mutex_};
+  auto it = timings_.find(event.module);
+  if (it == timings_.end()) {
+    it = timings_.emplace(std::string{event.module}, Timings{}).first;
+  }
+
+  auto &duration = event.phase == LaunchPhase::init ? it->second.init
+                                                    : it->second.teardown;
+  duration = event.duration;
+}
+
+void StartupProfile::set(std::string_view module, Timings timings) {
+  const std::lock_guard lock{mutex_};
+  timings_.insert_or_assign(std::string{module}, timings);
+}
+
+std::optional<StartupProfile::Timings> StartupProfile::find(
+    std::string_view module) const {
+  const std::lock_guard lock{mutex_};
+  if (const auto it = timings_.find(module); it != timings_.end()) {
+    return it->second;
+  }
+
+  return std::nullopt;
+}
+
+std::size_t StartupProfile::size() const noexcept {
+  const std::lock_guard lock{mutex_};
+  return timings_.size();
+}
+
+std::vector<std::chrono::nanoseconds> StartupProfile::costs(
+    Bundle bundle) const {
+  std::vector<std::chrono::nanoseconds> costs;
+  costs.reserve(bundle.size());
+
+  for (const auto &module : bundle) {
+    const auto timings = find(module.name());
+    costs.push_back(timings.has_value() ? timings->init : module.cost());
+  }
+
+  return costs;
+}
+
+std::vector<StartupProfile::Regression> StartupProfile::regressions(
+    const StartupProfile &baseline,
+    double factor,
+    std::chrono::nanoseconds threshold) const {
+  std::vector<Regression> regressions;
+
+  const auto check = [&](const std::string &module, LaunchPhase phase,
+                         std::chrono::nanoseconds was,
+                         std::chrono::nanoseconds now) {
+    if (was < threshold && now < threshold) {
+      return;
+    }
+
+    if (static_cast<double>(now.count())
+        >= static_cast<double>(was.count()) * factor) {
+      regressions.push_back({
+          .module = module,
+          .phase = phase,
+          .baseline = was,
+          .current = now,
+      });
+    }
+  };
+
+  // baseline could be this profile, do not hold the lock while using it
+  const auto current = std::invoke([this] {
+    const std::lock_guard lock{mutex_};
+    return timings_;
+  });
+
+  for (const auto &[module, timings] : current) {
+    const auto was = baseline.find(module);
+    if (!was.has_value()) {
+      continue;
+    }
+
+    check(module, LaunchPhase::init, was->init, timings.init);
+    check(module, LaunchPhase::teardown, was->teardown, timings.teardown);
+  }
+
+  return regressions;
+}
+
+std::string StartupProfile::serialize() const {
+  const std::lock_guard lock{mutex_};
+
+  std::string data{magic};
+  write(data, version);
+  write(data, static_cast<std::uint32_t>(timings_.size()));
+  for (const auto &[module, timings] : timings_) {
+    write(data, static_cast<std::uint16_t>(module.size()));
+    data += module;
+    write(data, static_cast<std::uint64_t>(timings.init.count()));
+    write(data, static_cast<std::uint64_t>(timings.teardown.count()));
+  }
+
+  return data;
+}
+
+stdext::expected<StartupProfile, std::string> StartupProfile::deserialize(
+    std::string_view data) {
+  using Expected = stdext::expected<StartupProfile, std::string>;
+  const auto error = [](std::string_view reason) {
+    return Expected{stdext::unexpected{
+        fmt::format("Invalid startup profile: {}", reason)}};
+  };
+
+  Reader reader{data};
+  if (reader.read(magic.size()) != magic) {
+    return error("bad magic");
+  }
+
+  if (const auto v = reader.read<std::uint8_t>(); v != version) {
+    return error("unsupported version");
+  }
+
+  const auto count = reader.read<std::uint32_t>();
+  if (!count.has_value()) {
+    return error("truncated");
+  }
+
+  StartupProfile profile;
+  for (std::uint32_t i = 0; i < *count; ++i) {
+    const auto size = reader.read<std::uint16_t>();
+    if (!size.has_value()) {
+      return error("truncated");
+    }
+
+    const auto module = reader.read(*size);
+    const auto init = reader.read<std::uint64_t>();
+    const auto teardown = reader.read<std::uint64_t>();
+    if (!module.has_value() || !init.has_value() || !teardown.has_value()) {
+      return error("truncated");
+    }
+
+    profile.timings_.insert_or_assign(
+        std::string{*module},
+        Timings{
+            .init = std::chrono::nanoseconds{static_cast<std::int64_t>(*init)},
+            .teardown = std::chrono::nanoseconds{
+                static_cast<std::int64_t>(*teardown)}});
+  }
+
+  if (!reader.empty()) {
+    return error("trailing data");
+  }
+
+  return profile;
+}
+
+stdext::expected<void, std::string> StartupProfile::save(
+    const std::filesystem::path &path) const {
+  const auto data = serialize();
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  if (!file) {
+    return stdext::unexpected{
+        fmt::format("Could not write startup profile '{}'", path.string())};
+  }
+
+  return {};
+}
+
+stdext::expected<StartupProfile, std::string> StartupProfile::load(
+    const std::filesystem::path &path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    return stdext::unexpected{
+        fmt::format("Could not read startup profile '{}'", path.string())};
+  }
+
+  const std::string data{
+      std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  return deserialize(data);
+}
+
+}  // namespace injectx::core
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/trace_event_observer.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace injectx::core {
+
+namespace {
+
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+}  // namespace
+
+TraceEventObserver::TraceEventObserver() noexcept
+    : origin_(LaunchEvent::Clock::now()) {
+}
+
+void TraceEventObserver::onEvent(const LaunchEvent &event) noexcept {
+  const std::lock_guard lock{mutex_};
+  events_.push_back(event);
+}
+
+std::vector<LaunchEvent> TraceEventObserver::events() const {
+  const std::lock_guard lock{mutex_};
+  return events_;
+}
+
+std::string TraceEventObserver::toJson() const {
+  const auto events = this->events();
+
+  // trace viewers expect small integer thread ids
+  std::vector<std::thread::id> threads;
+  const auto tid = [&threads](std::thread::id thread) {
+    auto it = std::find(threads.begin(), threads.end(), thread);
+    if (it == threads.end()) {
+      it = threads.insert(threads.end(), thread);
+    }
+
+    return std::distance(threads.begin(), it) + 1;
+  };
+
+  std::string json{R"({"traceEvents":[)"};
+  auto out = std::back_inserter(json);
+  for (const auto &event : events) {
+    if (&event != &events.front()) {
+      json += ',';
+    }
+
+    // module names are made of C++ identifiers, nothing to escape
+    fmt::format_to(
+        out,
+        R"({{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},)"
+        R"("pid":1,"tid":{}}})",
+        event.module, toString(event.phase),
+        Microseconds{event.start - origin_}.count(),
+        Microseconds{event.duration}.count(), tid(event.thread));
+  }
+
+  json += R"(],"displayTimeUnit":"ms"})";
+  return json;
+}
+
+}  // namespace injectx::core
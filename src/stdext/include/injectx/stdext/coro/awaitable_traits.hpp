@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coro/concepts.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace injectx::stdext::coro {
+
+template<typename T>
+concept awaitable_or_awaiter = awaitable<T> || awaiter<T>;
+
+// the awaiter which co_await would use for the awaitable
+template<awaitable_or_awaiter T>
+[[nodiscard]] decltype(auto) get_awaiter(T&& value) noexcept {
+  if constexpr (has_member_operator_co_await<T>) {
+    return std::forward<T>(value).operator co_await();
+  } else if constexpr (has_free_operator_co_await<T>) {
+    return operator co_await(std::forward<T>(value));
+  } else {
+    return std::forward<T>(value);
+  }
+}
+
+template<awaitable_or_awaiter T>
+using awaiter_t = decltype(get_awaiter(std::declval<T>()));
+
+// type of the co_await expression
+template<awaitable_or_awaiter T>
+using await_result_t =
+    decltype(std::declval<std::remove_reference_t<awaiter_t<T>>&>()
+                 .await_resume());
+
+// how an awaitable is kept by a coroutine which awaits it later: lvalues by
+// reference, rvalues by value
+template<typename T>
+using stored_t = std::conditional_t<
+    std::is_lvalue_reference_v<T>, T, std::remove_cvref_t<T>>;
+
+}  // namespace injectx::stdext::coro
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/export_macro.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace injectx::stdext::coro {
+
+// Monotonic memory for coroutine frames. While a scope is active on a thread,
+// the frames of coro::task, generator and everything built on them which are
+// created on that thread come from the arena. Freed frames are not reused,
+// the memory is released at once when the arena is destroyed, so it has to
+// outlive every frame allocated from it. Frames could be created and
+// destroyed on any thread.
+//
+// Every thread bump-allocates from a chunk of its own and only takes the
+// lock of the arena to get the next one. Frames carry no header, a frame is
+// found to be from an arena by the chunk it lies in, so frames allocated
+// without an arena cost the same as the global operator new.
+class INJECTX_STDEXT_EXPORT frame_arena {
+ public:
+  // Makes arena current on the calling thread until the end of the scope,
+  // nullptr makes frames use the global operator new.
+  class INJECTX_STDEXT_EXPORT scope {
+   public:
+    explicit scope(frame_arena* arena) noexcept;
+    ~scope();
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+   private:
+    frame_arena* previous_;
+  };
+
+  // chunks are aligned to their size, a frame which does not fit into one
+  // gets a block of several chunks
+  static constexpr std::size_t chunk_size = 64 * 1024;
+
+  frame_arena() noexcept;
+
+  // expects every frame to be destroyed
+  ~frame_arena();
+
+  frame_arena(const frame_arena&) = delete;
+  frame_arena& operator=(const frame_arena&) = delete;
+
+  // the arena of the calling thread or nullptr
+  [[nodiscard]] static frame_arena* current() noexcept;
+
+  // Used by the promise types, allocates from the current arena of the
+  // thread or the global operator new.
+  [[nodiscard]] static void* allocate_frame(std::size_t size);
+  static void deallocate_frame(void* frame) noexcept;
+
+  // number of frames which are still alive
+  [[nodiscard]] std::size_t frames() const noexcept {
+    return frames_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // tells a new arena from a destroyed one at the same address
+  std::uint64_t id_;
+  std::mutex mutex_;
+  std::vector<std::byte*> chunks_;
+  std::atomic<std::size_t> frames_{0};
+
+  // a registered chunk of at least size bytes or nullptr
+  [[nodiscard]] std::byte* allocate_chunk(std::size_t size);
+};
+
+}  // namespace injectx::stdext::coro
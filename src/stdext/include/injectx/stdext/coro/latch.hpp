@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coroutine.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace injectx::stdext::coro {
+
+// Countdown latch which coroutines co_await instead of blocking a thread.
+// Awaiting coroutines are pushed onto a lock-free list and resumed by the
+// count_down which reaches zero, on its thread and in reverse order.
+class latch {
+  class awaiter {
+   public:
+    explicit awaiter(const latch& latch) noexcept
+        : latch_(latch) {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept {
+      return latch_.is_ready();
+    }
+
+    [[nodiscard]] bool await_suspend(
+        stdext::coroutine_handle<> handle) noexcept {
+      handle_ = handle;
+
+      const void* const ready = &latch_;
+      void* old = latch_.waiters_.load(std::memory_order_acquire);
+      do {
+        if (old == ready) {
+          return false;
+        }
+
+        next_ = static_cast<awaiter*>(old);
+      } while (!latch_.waiters_.compare_exchange_weak(
+          old, this, std::memory_order_release, std::memory_order_acquire));
+
+      return true;
+    }
+
+    void await_resume() const noexcept {
+    }
+
+   private:
+    friend class latch;
+
+    const latch& latch_;
+    stdext::coroutine_handle<> handle_;
+    awaiter* next_{nullptr};
+  };
+
+ public:
+  explicit latch(std::ptrdiff_t count) noexcept
+      : count_(count),
+        waiters_(count > 0 ? nullptr : this) {
+  }
+
+  latch(const latch&) = delete;
+  latch& operator=(const latch&) = delete;
+
+  void count_down(std::ptrdiff_t n = 1) noexcept {
+    if (count_.fetch_sub(n, std::memory_order_acq_rel) == n) {
+      release();
+    }
+  }
+
+  [[nodiscard]] bool is_ready() const noexcept {
+    return waiters_.load(std::memory_order_acquire) == this;
+  }
+
+  [[nodiscard]] awaiter operator co_await() const noexcept {
+    return awaiter{*this};
+  }
+
+ private:
+  std::atomic<std::ptrdiff_t> count_;
+  // this once released, otherwise the list of awaiting coroutines
+  mutable std::atomic<void*> waiters_;
+
+  void release() noexcept {
+    auto* waiter = static_cast<awaiter*>(
+        waiters_.exchange(this, std::memory_order_acq_rel));
+    while (waiter != nullptr) {
+      // the awaiter lives in the frame of the coroutine being resumed
+      auto* next = waiter->next_;
+      waiter->handle_.resume();
+      waiter = next;
+    }
+  }
+};
+
+}  // namespace injectx::stdext::coro
@@ -6,6 +6,7 @@
 #include "injectx/stdext/coroutine.hpp"
 #include "injectx/stdext/export_macro.hpp"
 
+#include <cstddef>
 #include <exception>
 #include <utility>
 #include <variant>
@@ -92,6 +93,10 @@ class INJECTX_STDEXT_EXPORT resume_continuation {
 
 class INJECTX_STDEXT_EXPORT promise_continuation {
  public:
+  // frames come from the frame_arena of the creating thread, if there is one
+  [[nodiscard]] static void* operator new(std::size_t size);
+  static void operator delete(void* frame, std::size_t size) noexcept;
+
   [[nodiscard]] stdext::suspend_always initial_suspend() const noexcept;
   [[nodiscard]] resume_continuation final_suspend() const noexcept;
 
@@ -105,10 +110,13 @@ class INJECTX_STDEXT_EXPORT promise_continuation {
   std::atomic<bool> state_{false};
 
  public:
+  // re-armed on every suspend, so a coroutine could be awaited again after
+  // it has suspended in the middle, e.g. on co_yield
   template <typename Promise>
   [[nodiscard]] bool suspend(
       stdext::coroutine_handle<> awaitingHandle,
       stdext::coroutine_handle<Promise> currentHandle) noexcept {
+    state_.store(false, std::memory_order_relaxed);
     currentHandle.resume();
     continuation_ = awaitingHandle;
     return !state_.exchange(true, std::memory_order_acq_rel);
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coro/awaitable_traits.hpp"
+#include "injectx/stdext/coroutine.hpp"
+
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace injectx::stdext::coro {
+
+namespace details::_spawn {
+
+// Starts eagerly and destroys itself once finished.
+struct detached {
+  struct promise_type {
+    detached get_return_object() const noexcept {
+      return {};
+    }
+
+    stdext::suspend_never initial_suspend() const noexcept {
+      return {};
+    }
+
+    stdext::suspend_never final_suspend() const noexcept {
+      return {};
+    }
+
+    void return_void() const noexcept {
+    }
+
+    void unhandled_exception() const noexcept {
+      std::terminate();
+    }
+  };
+};
+
+}  // namespace details::_spawn
+
+// Awaits the awaitable without blocking the caller and invokes callback with
+// the result of co_await on the thread which completed it, which might be the
+// calling thread. An rvalue awaitable is moved into the coroutine frame, an
+// lvalue one is awaited by reference and has to outlive the completion.
+template<awaitable_or_awaiter Awaitable, typename Callback>
+void spawn(Awaitable&& awaitable, Callback&& callback) {
+  using Stored = stored_t<Awaitable>;
+
+  std::invoke(
+      [](Stored awaitable,
+         std::decay_t<Callback> callback) -> details::_spawn::detached {
+        if constexpr (std::is_void_v<await_result_t<Awaitable>>) {
+          co_await static_cast<Stored&&>(awaitable);
+          std::invoke(callback);
+        } else {
+          std::invoke(callback, co_await static_cast<Stored&&>(awaitable));
+        }
+      },
+      std::forward<Awaitable>(awaitable), std::forward<Callback>(callback));
+}
+
+}  // namespace injectx::stdext::coro
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coro/awaitable_traits.hpp"
+#include "injectx/stdext/coro/spawn.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace injectx::stdext::coro {
+
+namespace details::_sync_wait {
+
+template<typename Result>
+struct state {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done{false};
+  std::conditional_t<std::is_void_v<Result>, bool, std::optional<Result>>
+      result{};
+  std::exception_ptr exception;
+
+  void complete() {
+    const std::lock_guard lock{mutex};
+    done = true;
+    cv.notify_one();
+  }
+};
+
+template<typename Result, typename Stored>
+_spawn::detached run(Stored awaitable, state<Result>& state) {
+  try {
+    if constexpr (std::is_void_v<Result>) {
+      co_await static_cast<Stored&&>(awaitable);
+    } else {
+      state.result.emplace(co_await static_cast<Stored&&>(awaitable));
+    }
+  } catch (...) {
+    state.exception = std::current_exception();
+  }
+
+  state.complete();
+}
+
+}  // namespace details::_sync_wait
+
+// Blocks the calling thread until the awaitable completes, on this or any
+// other thread, and returns the result of co_await or rethrows its exception.
+template<awaitable_or_awaiter Awaitable>
+[[nodiscard]] auto sync_wait(Awaitable&& awaitable) {
+  using Result = std::remove_cvref_t<await_result_t<Awaitable>>;
+
+  details::_sync_wait::state<Result> state;
+  details::_sync_wait::run<Result, stored_t<Awaitable>>(
+      std::forward<Awaitable>(awaitable), state);
+
+  std::unique_lock lock{state.mutex};
+  state.cv.wait(lock, [&state] {
+    return state.done;
+  });
+
+  if (state.exception) {
+    std::rethrow_exception(state.exception);
+  }
+
+  if constexpr (!std::is_void_v<Result>) {
+    return std::move(state.result).value();
+  }
+}
+
+}  // namespace injectx::stdext::coro
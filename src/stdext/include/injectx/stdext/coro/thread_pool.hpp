@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coroutine.hpp"
+#include "injectx/stdext/export_macro.hpp"
+#include "injectx/stdext/static_mpmc_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace injectx::stdext::coro {
+
+// Resumes coroutines on a fixed set of worker threads. Every worker owns a
+// queue: coroutines scheduled from a worker go to its own queue and are
+// resumed in LIFO order while they are hot in cache, idle workers steal the
+// oldest coroutines from the other queues. Coroutines scheduled from other
+// threads go to a shared lock-free queue, or to an overflow queue under a
+// mutex when it is full.
+class INJECTX_STDEXT_EXPORT thread_pool {
+ public:
+  class schedule_operation {
+   public:
+    explicit schedule_operation(thread_pool& pool) noexcept
+        : pool_(&pool) {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(stdext::coroutine_handle<> handle) const {
+      pool_->enqueue(handle);
+    }
+
+    void await_resume() const noexcept {
+    }
+
+   private:
+    thread_pool* pool_;
+  };
+
+  explicit thread_pool(
+      std::size_t threads = std::thread::hardware_concurrency());
+
+  // resumes everything which is still scheduled, then joins the workers
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  // co_await continues the awaiting coroutine on one of the workers
+  [[nodiscard]] schedule_operation schedule() noexcept {
+    return schedule_operation{*this};
+  }
+
+  void enqueue(stdext::coroutine_handle<> handle);
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return workers_.size();
+  }
+
+  // true on the workers of this pool
+  [[nodiscard]] bool owns_current_thread() const noexcept;
+
+ private:
+  struct queue {
+    std::mutex mutex;
+    std::deque<stdext::coroutine_handle<>> handles;
+  };
+
+  std::vector<std::unique_ptr<queue>> queues_;
+  stdext::static_mpmc_queue<stdext::coroutine_handle<>, 1024> shared_;
+  std::deque<stdext::coroutine_handle<>> overflow_;
+  std::atomic<std::size_t> pending_{0};
+  bool stopping_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::thread> workers_;
+
+  void run(std::size_t index);
+
+  [[nodiscard]] stdext::coroutine_handle<> pop(std::size_t index);
+};
+
+}  // namespace injectx::stdext::coro
@@ -0,0 +1,338 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coro/awaitable_traits.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coroutine.hpp"
+#include "injectx/stdext/expected.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace injectx::stdext::coro {
+
+namespace details::_when_all {
+
+// Counts awaitables which are still running. It starts with one extra count
+// which belongs to the awaiting coroutine, so the last one to finish, either
+// an awaitable or the awaiting coroutine after it has started all of them,
+// is the one which continues.
+class counter {
+ public:
+  explicit counter(std::size_t count) noexcept
+      : count_(count + 1) {
+  }
+
+  // false when every awaitable has already finished
+  [[nodiscard]] bool try_await(stdext::coroutine_handle<> awaiting) noexcept {
+    awaiting_ = awaiting;
+    return count_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+  }
+
+  void notify() noexcept {
+    if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      awaiting_.resume();
+    }
+  }
+
+ private:
+  std::atomic<std::size_t> count_;
+  stdext::coroutine_handle<> awaiting_;
+};
+
+template<typename T>
+class runner;
+
+template<typename T>
+class runner_promise : public _task::promise_base<T> {
+ public:
+  using value_type = T;
+
+  [[nodiscard]] runner<T> get_return_object() noexcept {
+    return runner<T>{
+        stdext::coroutine_handle<runner_promise>::from_promise(*this)};
+  }
+
+  [[nodiscard]] stdext::suspend_always initial_suspend() const noexcept {
+    return {};
+  }
+
+  [[nodiscard]] auto final_suspend() const noexcept {
+    struct notify_counter {
+      [[nodiscard]] bool await_ready() const noexcept {
+        return false;
+      }
+
+      void await_suspend(
+          stdext::coroutine_handle<runner_promise> handle) const noexcept {
+        handle.promise().counter_->notify();
+      }
+
+      void await_resume() const noexcept {
+      }
+    };
+
+    return notify_counter{};
+  }
+
+  void start(counter& counter, stdext::coroutine_handle<> handle) noexcept {
+    counter_ = &counter;
+    handle.resume();
+  }
+
+ private:
+  counter* counter_{nullptr};
+};
+
+// void results are std::monostate, so they fit into a tuple
+template<typename T>
+using result_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template<typename T>
+class runner {
+ public:
+  using promise_type = runner_promise<T>;
+  using handle_type = stdext::coroutine_handle<promise_type>;
+
+  explicit runner(handle_type handle) noexcept
+      : handle_(handle) {
+  }
+
+  runner(runner&& that) noexcept
+      : handle_(std::exchange(that.handle_, nullptr)) {
+  }
+
+  runner(const runner&) = delete;
+  runner& operator=(const runner&) = delete;
+  runner& operator=(runner&&) = delete;
+
+  ~runner() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  void start(counter& counter) noexcept {
+    handle_.promise().start(counter, handle_);
+  }
+
+  [[nodiscard]] result_t<T> result() {
+    if constexpr (std::is_void_v<T>) {
+      handle_.promise().result();
+      return {};
+    } else {
+      return handle_.promise().result();
+    }
+  }
+
+ private:
+  handle_type handle_;
+};
+
+// the co_await result, an rvalue reference is returned by value
+template<typename Awaitable>
+using runner_value_t = std::conditional_t<
+    std::is_rvalue_reference_v<await_result_t<Awaitable>>,
+    std::remove_cvref_t<await_result_t<Awaitable>>,
+    await_result_t<Awaitable>>;
+
+template<typename Stored>
+[[nodiscard]] runner<runner_value_t<Stored>> make_runner(Stored awaitable) {
+  if constexpr (std::is_void_v<runner_value_t<Stored>>) {
+    co_await static_cast<Stored&&>(awaitable);
+  } else {
+    co_return co_await static_cast<Stored&&>(awaitable);
+  }
+}
+
+template<typename... Ts>
+class [[nodiscard]] awaitable {
+ public:
+  explicit awaitable(runner<Ts>&&... runners) noexcept
+      : runners_(std::move(runners)...) {
+  }
+
+  awaitable(const awaitable&) = delete;
+  awaitable& operator=(const awaitable&) = delete;
+
+  [[nodiscard]] bool await_ready() const noexcept {
+    return sizeof...(Ts) == 0;
+  }
+
+  [[nodiscard]] bool await_suspend(
+      stdext::coroutine_handle<> awaiting) noexcept {
+    std::apply(
+        [this](auto&... runners) {
+          (runners.start(counter_), ...);
+        },
+        runners_);
+
+    return counter_.try_await(awaiting);
+  }
+
+  // rethrows the first exception in argument order
+  [[nodiscard]] std::tuple<result_t<Ts>...> await_resume() {
+    return std::apply(
+        [](auto&... runners) {
+          return std::tuple<result_t<Ts>...>{runners.result()...};
+        },
+        runners_);
+  }
+
+ private:
+  counter counter_{sizeof...(Ts)};
+  std::tuple<runner<Ts>...> runners_;
+};
+
+template<typename T>
+class [[nodiscard]] range_awaitable {
+ public:
+  explicit range_awaitable(std::vector<runner<T>> runners) noexcept
+      : counter_(runners.size()),
+        runners_(std::move(runners)) {
+  }
+
+  range_awaitable(const range_awaitable&) = delete;
+  range_awaitable& operator=(const range_awaitable&) = delete;
+
+  [[nodiscard]] bool await_ready() const noexcept {
+    return runners_.empty();
+  }
+
+  [[nodiscard]] bool await_suspend(
+      stdext::coroutine_handle<> awaiting) noexcept {
+    for (auto& runner : runners_) {
+      runner.start(counter_);
+    }
+
+    return counter_.try_await(awaiting);
+  }
+
+  // rethrows the first exception in range order
+  [[nodiscard]] std::vector<result_t<T>> await_resume() {
+    std::vector<result_t<T>> results;
+    results.reserve(runners_.size());
+    for (auto& runner : runners_) {
+      results.push_back(runner.result());
+    }
+
+    return results;
+  }
+
+ private:
+  counter counter_;
+  std::vector<runner<T>> runners_;
+};
+
+// elements of an lvalue range are awaited by reference, of an rvalue one are
+// moved into the operation
+template<typename Range>
+using range_element_t = std::conditional_t<
+    std::is_lvalue_reference_v<Range>,
+    stored_t<std::ranges::range_reference_t<Range>>,
+    std::remove_cvref_t<std::ranges::range_reference_t<Range>>>;
+
+template<typename T, typename E>
+[[nodiscard]] result_t<T> value_of(stdext::expected<T, E>& expected) {
+  if constexpr (std::is_void_v<T>) {
+    return {};
+  } else {
+    return std::move(expected).value();
+  }
+}
+
+}  // namespace details::_when_all
+
+// Starts every awaitable on the awaiting thread and continues on the thread
+// which finishes the last one. co_await returns a tuple of their results,
+// void results are std::monostate. An rvalue awaitable is moved into the
+// operation, an lvalue one is awaited by reference.
+template<awaitable_or_awaiter... Awaitables>
+[[nodiscard]] auto when_all(Awaitables&&... awaitables) {
+  namespace impl = details::_when_all;
+
+  return impl::awaitable<impl::runner_value_t<stored_t<Awaitables>>...>{
+      impl::make_runner<stored_t<Awaitables>>(
+          std::forward<Awaitables>(awaitables))...};
+}
+
+// Same as above for a range of awaitables, co_await returns a vector of their
+// results in range order. An empty range completes immediately.
+template<std::ranges::input_range Range>
+  requires awaitable_or_awaiter<std::ranges::range_reference_t<Range>>
+[[nodiscard]] auto when_all(Range&& awaitables) {
+  namespace impl = details::_when_all;
+  using Element = impl::range_element_t<Range>;
+  using Value = impl::runner_value_t<Element>;
+
+  std::vector<impl::runner<Value>> runners;
+  if constexpr (std::ranges::sized_range<Range>) {
+    runners.reserve(std::ranges::size(awaitables));
+  }
+
+  for (auto&& awaitable : awaitables) {
+    runners.push_back(
+        impl::make_runner<Element>(static_cast<Element&&>(awaitable)));
+  }
+
+  return impl::range_awaitable<Value>{std::move(runners)};
+}
+
+// Turns the results of when_all of expected values into an expected of all
+// values, or the first error in argument order.
+template<typename E, typename... Ts>
+[[nodiscard]] stdext::expected<
+    std::tuple<details::_when_all::result_t<Ts>...>, E>
+    collect(std::tuple<stdext::expected<Ts, E>...>&& results) {
+  namespace impl = details::_when_all;
+
+  std::optional<E> error;
+  std::apply(
+      [&error](auto&... results) {
+        ((error.has_value() || results.has_value()
+              ? void()
+              : void(error.emplace(std::move(results).error()))),
+         ...);
+      },
+      results);
+
+  if (error.has_value()) {
+    return stdext::unexpected{std::move(error).value()};
+  }
+
+  return std::apply(
+      [](auto&... results) {
+        return std::tuple<impl::result_t<Ts>...>{impl::value_of(results)...};
+      },
+      results);
+}
+
+// Same as above for the results of when_all of a range, first error in range
+// order.
+template<typename T, typename E>
+[[nodiscard]] stdext::expected<
+    std::vector<details::_when_all::result_t<T>>, E>
+    collect(std::vector<stdext::expected<T, E>>&& results) {
+  std::vector<details::_when_all::result_t<T>> values;
+  values.reserve(results.size());
+  for (auto& result : results) {
+    if (!result.has_value()) {
+      return stdext::unexpected{std::move(result).error()};
+    }
+
+    values.push_back(details::_when_all::value_of(result));
+  }
+
+  return values;
+}
+
+}  // namespace injectx::stdext::coro
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coro/awaitable_traits.hpp"
+#include "injectx/stdext/coro/when_all.hpp"
+#include "injectx/stdext/coroutine.hpp"
+#include "injectx/stdext/expects.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace injectx::stdext::coro {
+
+namespace details::_when_any {
+
+// the result of an awaitable, references are copied
+template<typename Stored>
+using value_t = _when_all::result_t<
+    std::remove_cvref_t<_when_all::runner_value_t<Stored>>>;
+
+// Shared by the operation and every awaitable, the awaitables which finish
+// after the first one still use it.
+template<typename Result>
+class state {
+ public:
+  // only the first call stores its result and continues the awaiting
+  // coroutine, emplace receives the storage of the result
+  template<typename F>
+  void complete(F&& emplace) noexcept {
+    if (decided_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+
+    try {
+      std::forward<F>(emplace)(result_);
+    } catch (...) {
+      exception_ = std::current_exception();
+    }
+
+    counter_.notify();
+  }
+
+  void fail(std::exception_ptr exception) noexcept {
+    if (decided_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+
+    exception_ = std::move(exception);
+    counter_.notify();
+  }
+
+  [[nodiscard]] bool try_await(stdext::coroutine_handle<> awaiting) noexcept {
+    return counter_.try_await(awaiting);
+  }
+
+  [[nodiscard]] Result result() {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+
+    return std::move(result_).value();
+  }
+
+ private:
+  _when_all::counter counter_{1};
+  std::atomic<bool> decided_{false};
+  std::optional<Result> result_;
+  std::exception_ptr exception_;
+};
+
+// Starts on start() and destroys itself once finished, a runner which has
+// never been started is destroyed with its owner.
+class runner {
+ public:
+  struct promise_type {
+    runner get_return_object() noexcept {
+      return runner{
+          stdext::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    stdext::suspend_always initial_suspend() const noexcept {
+      return {};
+    }
+
+    stdext::suspend_never final_suspend() const noexcept {
+      return {};
+    }
+
+    void return_void() const noexcept {
+    }
+
+    void unhandled_exception() const noexcept {
+      std::terminate();
+    }
+  };
+
+  explicit runner(stdext::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {
+  }
+
+  runner(runner&& that) noexcept
+      : handle_(std::exchange(that.handle_, nullptr)) {
+  }
+
+  runner(const runner&) = delete;
+  runner& operator=(const runner&) = delete;
+  runner& operator=(runner&&) = delete;
+
+  ~runner() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  void start() noexcept {
+    std::exchange(handle_, nullptr).resume();
+  }
+
+ private:
+  stdext::coroutine_handle<promise_type> handle_;
+};
+
+// emplace receives the storage of the result and the value of the awaitable
+template<typename Stored, typename Result, typename Emplace>
+[[nodiscard]] runner make_runner(
+    Stored awaitable, std::shared_ptr<state<Result>> state, Emplace emplace) {
+  try {
+    if constexpr (std::is_void_v<_when_all::runner_value_t<Stored>>) {
+      co_await static_cast<Stored&&>(awaitable);
+      state->complete([&emplace](auto& result) {
+        emplace(result, std::monostate{});
+      });
+    } else {
+      auto&& value = co_await static_cast<Stored&&>(awaitable);
+      state->complete([&emplace, &value](auto& result) {
+        emplace(result, std::forward<decltype(value)>(value));
+      });
+    }
+  } catch (...) {
+    state->fail(std::current_exception());
+  }
+}
+
+template<typename Result>
+class [[nodiscard]] awaitable {
+ public:
+  awaitable(
+      std::shared_ptr<state<Result>> state,
+      std::vector<runner> runners) noexcept
+      : state_(std::move(state)),
+        runners_(std::move(runners)) {
+  }
+
+  [[nodiscard]] bool await_ready() const noexcept {
+    return false;
+  }
+
+  [[nodiscard]] bool await_suspend(
+      stdext::coroutine_handle<> awaiting) noexcept {
+    for (auto& runner : runners_) {
+      runner.start();
+    }
+
+    return state_->try_await(awaiting);
+  }
+
+  [[nodiscard]] Result await_resume() {
+    return state_->result();
+  }
+
+ private:
+  std::shared_ptr<state<Result>> state_;
+  std::vector<runner> runners_;
+};
+
+}  // namespace details::_when_any
+
+// Starts every awaitable on the awaiting thread and continues on the thread
+// which finishes the first one. co_await returns a variant whose index is the
+// index of that awaitable, void results are std::monostate, or rethrows its
+// exception. There is no cancellation: the other awaitables keep running and
+// their results are dropped, so lvalue awaitables have to outlive all of
+// them. rvalue awaitables are moved into the operation.
+template<awaitable_or_awaiter... Awaitables>
+  requires(sizeof...(Awaitables) > 0)
+[[nodiscard]] auto when_any(Awaitables&&... awaitables) {
+  namespace impl = details::_when_any;
+  using Result = std::variant<impl::value_t<stored_t<Awaitables>>...>;
+
+  auto state = std::make_shared<impl::state<Result>>();
+  std::vector<impl::runner> runners;
+  runners.reserve(sizeof...(Awaitables));
+
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (runners.push_back(impl::make_runner<stored_t<Awaitables>>(
+         std::forward<Awaitables>(awaitables), state,
+         [](auto& result, auto&& value) {
+           result.emplace(
+               std::in_place_index<Is>, std::forward<decltype(value)>(value));
+         })),
+     ...);
+  }(std::index_sequence_for<Awaitables...>{});
+
+  return impl::awaitable<Result>{std::move(state), std::move(runners)};
+}
+
+// Same as above for a non-empty range of awaitables, co_await returns the
+// index of the first one to finish and its result.
+template<std::ranges::input_range Range>
+  requires awaitable_or_awaiter<std::ranges::range_reference_t<Range>>
+[[nodiscard]] auto when_any(Range&& awaitables) {
+  namespace impl = details::_when_any;
+  using Element = details::_when_all::range_element_t<Range>;
+  using Result = std::pair<std::size_t, impl::value_t<Element>>;
+
+  auto state = std::make_shared<impl::state<Result>>();
+  std::vector<impl::runner> runners;
+  if constexpr (std::ranges::sized_range<Range>) {
+    runners.reserve(std::ranges::size(awaitables));
+  }
+
+  for (auto&& awaitable : awaitables) {
+    runners.push_back(impl::make_runner<Element>(
+        static_cast<Element&&>(awaitable), state,
+        [index = runners.size()](auto& result, auto&& value) {
+          result.emplace(index, std::forward<decltype(value)>(value));
+        }));
+  }
+
+  stdext::expects(!runners.empty());
+  return impl::awaitable<Result>{std::move(state), std::move(runners)};
+}
+
+}  // namespace injectx::stdext::coro
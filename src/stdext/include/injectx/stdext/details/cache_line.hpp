@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+
+namespace injectx::stdext::details {
+
+// std::hardware_destructive_interference_size is not stable across compiler
+// flags, which makes it unsuitable for the layout of types in headers.
+inline constexpr std::size_t cache_line_size = 64;
+
+}  // namespace injectx::stdext::details
@@ -3,18 +3,46 @@
 
 #pragma once
 
-#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coro/promise.hpp"
+#include "injectx/stdext/coroutine.hpp"
 
 #include <concepts>
+#include <cstddef>
+#include <exception>
 #include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
 
 namespace injectx::stdext {
 
 template<typename T>
 class [[nodiscard]] generator;
 
+// co_yield elements_of(range) yields every element of the range. A nested
+// generator of the same type is resumed directly by the outermost one, so
+// every element costs one resume regardless of the depth.
+template<std::ranges::range R>
+struct elements_of {
+  explicit elements_of(R&& range) noexcept
+      : range(std::forward<R>(range)) {
+  }
+
+  R range;
+};
+
+template<typename R>
+elements_of(R&&) -> elements_of<R&&>;
+
 namespace details::_generator {
 
+template<typename T>
+inline constexpr bool IsElementsOf = false;
+
+template<typename R>
+inline constexpr bool IsElementsOf<elements_of<R>> = true;
+
 template<typename T>
 concept HasValueType = requires { typename T::value_type; };
 
@@ -30,75 +58,313 @@ constexpr auto defaultValueType() {
 template<typename T>
 using DefaultValueType = typename decltype(defaultValueType<T>())::type;
 
+// Points the outermost promise at the yielded object until the generator is
+// resumed. Nested generators form a chain from the outermost promise, the
+// root, to the innermost one, the leaf, which is the one to resume.
 template<typename T>
-class promise : public coro::promise_storage<T>,
-                public coro::promise_continuation {
+class promise : public coro::promise_continuation {
+  using handle_type = stdext::coroutine_handle<promise>;
+
+  // continues the parent after a nested generator has finished
+  class final_awaiter {
+   public:
+    [[nodiscard]] bool await_ready() const noexcept {
+      return false;
+    }
+
+#ifdef INJECTX_STDEXT_CORO_NO_SYMMETRIC_TRANSFER
+    // the root resumes the parent, see promise::resume()
+    void await_suspend(handle_type handle) const noexcept {
+      auto& promise = handle.promise();
+      if (promise.parent_) {
+        promise.root_->leaf_ = promise.parent_;
+        promise.root_->transferred_ = true;
+      }
+    }
+#else  // symmetric transfer
+    [[nodiscard]] stdext::coroutine_handle<> await_suspend(
+        handle_type handle) const noexcept {
+      auto& promise = handle.promise();
+      if (!promise.parent_) {
+        return stdext::noop_coroutine();
+      }
+
+      promise.root_->leaf_ = promise.parent_;
+      return promise.parent_;
+    }
+#endif
+
+    void await_resume() const noexcept {
+    }
+  };
+
+  // transfers to a nested generator, which becomes the leaf
+  class nested_awaiter {
+   public:
+    explicit nested_awaiter(
+        handle_type nested, generator<T> owned = generator<T>{nullptr}) noexcept
+        : nested_(nested),
+          owned_(std::move(owned)) {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept {
+      return !nested_ || nested_.done();
+    }
+
+#ifdef INJECTX_STDEXT_CORO_NO_SYMMETRIC_TRANSFER
+    // the root resumes the nested generator, see promise::resume()
+    void await_suspend(handle_type parent) const noexcept {
+      auto& root = link(parent);
+      root.transferred_ = true;
+    }
+#else  // symmetric transfer
+    [[nodiscard]] stdext::coroutine_handle<> await_suspend(
+        handle_type parent) const noexcept {
+      link(parent);
+      return nested_;
+    }
+#endif
+
+    // rethrows an exception which escaped the nested generator
+    void await_resume() const {
+      if (nested_) {
+        nested_.promise().rethrow_if_exception();
+      }
+    }
+
+   private:
+    handle_type nested_;
+    generator<T> owned_;
+
+    // returns the root, whose leaf is the nested generator now
+    promise& link(handle_type parent) const noexcept {
+      auto& root = *parent.promise().root_;
+      auto& nested = nested_.promise();
+      nested.root_ = &root;
+      nested.parent_ = parent;
+      root.leaf_ = nested_;
+      return root;
+    }
+  };
+
  public:
+  using value_type = std::remove_cvref_t<T>;
+  using reference = std::add_lvalue_reference_t<T>;
+
+  promise() noexcept
+      : root_(this),
+        leaf_(handle_type::from_promise(*this)) {
+  }
+
   [[nodiscard]] generator<T> get_return_object() noexcept;
 
-  suspend_always final_suspend() noexcept {
+  [[nodiscard]] final_awaiter final_suspend() noexcept {
+    return {};
+  }
+
+  // the yielded object outlives the suspension, it is a local of the
+  // coroutine or a temporary of the co_yield expression
+  stdext::suspend_always yield_value(reference value) noexcept {
+    root_->value_ = std::addressof(value);
     return {};
   }
 
-  template<typename From = DefaultValueType<T>>
-    requires std::constructible_from<T, From>
-  coro::resume_continuation yield_value(From&& from) {
-    coro::promise_storage<T>::set(std::forward<From>(from));
+  stdext::suspend_always yield_value(
+      std::remove_reference_t<T>&& value) noexcept {
+    root_->value_ = std::addressof(value);
     return {};
   }
 
+  template<typename R>
+    requires std::same_as<std::remove_cvref_t<R>, generator<T>>
+  [[nodiscard]] nested_awaiter yield_value(elements_of<R> elements) noexcept {
+    return nested_awaiter{elements.range.handle_};
+  }
+
+  // any other range is iterated by a nested generator
+  template<typename R>
+    requires(!std::same_as<std::remove_cvref_t<R>, generator<T>>)
+            && std::constructible_from<
+                value_type, std::ranges::range_reference_t<R>>
+  [[nodiscard]] nested_awaiter yield_value(elements_of<R> elements) {
+    auto nested = flatten(elements.range);
+    const auto handle = nested.handle_;
+    return nested_awaiter{handle, std::move(nested)};
+  }
+
+  // anything else is converted into the awaiter, e.g. co_yield {...}
+  template<typename From = DefaultValueType<value_type>>
+    requires(!IsElementsOf<std::remove_cvref_t<From>>)
+            && std::constructible_from<value_type, From>
+  auto yield_value(From&& from) {
+    class awaiter : public stdext::suspend_always {
+     public:
+      awaiter(promise& promise, From&& from)
+          : promise_(&promise),
+            value_(std::forward<From>(from)) {
+      }
+
+      void await_suspend(stdext::coroutine_handle<>) noexcept {
+        promise_->root_->value_ = std::addressof(value_);
+      }
+
+     private:
+      promise* promise_;
+      value_type value_;
+    };
+
+    return awaiter{*this, std::forward<From>(from)};
+  }
+
   void return_void() const noexcept {
   }
+
+  void unhandled_exception() noexcept {
+    exception_ = std::current_exception();
+  }
+
+  [[nodiscard]] reference value() const noexcept {
+    return static_cast<reference>(*value_);
+  }
+
+  void rethrow_if_exception() {
+    if (exception_) {
+      std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+  }
+
+#ifdef INJECTX_STDEXT_CORO_NO_SYMMETRIC_TRANSFER
+  // Resumes the innermost nested generator. Without symmetric transfer
+  // every switch between nested generators returns here and the next leaf
+  // is resumed by the loop, so the stack does not grow with every finished
+  // or started nested generator.
+  void resume() {
+    do {
+      transferred_ = false;
+      leaf_.resume();
+    } while (transferred_);
+  }
+#else  // symmetric transfer
+  // resumes the innermost nested generator
+  void resume() const {
+    leaf_.resume();
+  }
+#endif
+
+ private:
+  promise* root_;
+  handle_type parent_;
+  handle_type leaf_;
+  std::add_pointer_t<reference> value_{nullptr};
+  std::exception_ptr exception_;
+#ifdef INJECTX_STDEXT_CORO_NO_SYMMETRIC_TRANSFER
+  // set by a root's leaf which suspends to switch to another one
+  bool transferred_{false};
+#endif
+
+  template<typename R>
+  static generator<T> flatten(R& range) {
+    for (auto&& element : range) {
+      co_yield std::forward<decltype(element)>(element);
+    }
+  }
 };
 
-template<typename Task>
+template<typename T>
 class [[nodiscard]] iterator {
  public:
-  using value_type = typename Task::promise_type::value_type;
+  using value_type = typename promise<T>::value_type;
+  using reference = typename promise<T>::reference;
   using difference_type = std::ptrdiff_t;
+  using handle_type = stdext::coroutine_handle<promise<T>>;
 
-  explicit iterator(Task& task) noexcept
-      : task_(task) {
+  iterator() noexcept = default;
+
+  explicit iterator(handle_type handle) noexcept
+      : handle_(handle) {
   }
 
   iterator& operator++() {
-    (void)task_.resume();
+    resume(handle_);
     return *this;
   }
 
-  [[nodiscard]] value_type operator*() const noexcept {
-    return task_.promise().result();
+  void operator++(int) {
+    ++*this;
+  }
+
+  [[nodiscard]] reference operator*() const noexcept {
+    return handle_.promise().value();
   }
 
   [[nodiscard]] friend bool operator==(
-      const iterator& it, std::default_sentinel_t) {
-    const auto res = it.task_.is_ready();
-    return res.has_value() && res.value();
+      const iterator& it, std::default_sentinel_t) noexcept {
+    return !it.handle_ || it.handle_.done();
+  }
+
+  // resumes until the next co_yield or the end, rethrows an exception which
+  // escaped the coroutine
+  static void resume(handle_type handle) {
+    if (!handle || handle.done()) {
+      return;
+    }
+
+    handle.promise().resume();
+    handle.promise().rethrow_if_exception();
   }
 
  private:
-  Task& task_;
+  handle_type handle_;
 };
 
 }  // namespace details::_generator
 
+// A lazy input range of the values yielded by the coroutine. Dereferencing
+// an iterator returns a reference to the yielded object, which is valid
+// until the generator is resumed. Lvalues and rvalues of T are not copied.
+// Every call of begin() resumes the coroutine, so a generator could be
+// iterated in several passes, each one continues where the previous stopped.
 template<typename T>
-class [[nodiscard]] generator {
-  using Task = coro::task<T, details::_generator::promise>;
+class [[nodiscard]] generator
+    : public std::ranges::view_interface<generator<T>> {
+  friend details::_generator::promise<T>;
 
  public:
-  using value_type = typename Task::value_type;
-  using promise_type = typename Task::promise_type;
-  using handle_type = typename stdext::coroutine_handle<promise_type>;
+  using promise_type = details::_generator::promise<T>;
+  using value_type = typename promise_type::value_type;
+  using handle_type = stdext::coroutine_handle<promise_type>;
 
   explicit generator(handle_type handle) noexcept
-      : task_(std::move(handle)) {
+      : handle_(handle) {
+  }
+
+  generator(generator&& that) noexcept
+      : handle_(std::exchange(that.handle_, nullptr)) {
+  }
+
+  generator& operator=(generator&& that) noexcept {
+    if (std::addressof(that) != this) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(that.handle_, nullptr);
+    }
+
+    return *this;
+  }
+
+  generator(const generator&) = delete;
+  generator& operator=(const generator&) = delete;
+
+  ~generator() {
+    if (handle_) {
+      handle_.destroy();
+    }
   }
 
-  auto begin() noexcept {
-    auto it = details::_generator::iterator{task_};
-    ++it;
-    return it;
+  [[nodiscard]] auto begin() {
+    details::_generator::iterator<T>::resume(handle_);
+    return details::_generator::iterator<T>{handle_};
   }
 
   [[nodiscard]] auto end() const noexcept {
@@ -106,7 +372,7 @@ class [[nodiscard]] generator {
   }
 
  private:
-  Task task_;
+  handle_type handle_;
 };
 
 namespace details::_generator {
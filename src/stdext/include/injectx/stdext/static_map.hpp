@@ -5,6 +5,7 @@
 
 #include "injectx/stdext/expected.hpp"
 
+#include <algorithm>
 #include <array>
 #include <iterator>
 #include <optional>
@@ -52,6 +53,112 @@ class [[nodiscard]] iterator_wrapper {
 
 }  // namespace details::_static_map
 
+// Immutable map built once from all its entries. Entries are sorted by key, so
+// construction is O(N log N) and find() is a binary search, both in constant
+// evaluation and at runtime.
+template<typename Key, typename Value, std::size_t MaxSize>
+class frozen_static_map {
+ public:
+  using value_type = std::pair<Key, Value>;
+  using key_type = Key;
+  using mapped_type = Value;
+  using container_type = std::array<value_type, MaxSize>;
+  using const_iterator = typename container_type::const_iterator;
+  using iterator = const_iterator;
+
+  // indexes of the entries with equal keys, first < second
+  struct duplicate_keys {
+    std::size_t first;
+    std::size_t second;
+  };
+
+  constexpr frozen_static_map() = default;
+
+  [[nodiscard]] static constexpr expected<frozen_static_map, duplicate_keys>
+      make(const container_type& entries) noexcept {
+    return make(entries, MaxSize);
+  }
+
+  // only the first size entries are used
+  [[nodiscard]] static constexpr expected<frozen_static_map, duplicate_keys>
+      make(const container_type& entries, std::size_t size) noexcept {
+    std::array<std::size_t, MaxSize> order{};
+    for (std::size_t i = 0; i < size; ++i) {
+      order[i] = i;
+    }
+
+    // equal keys stay in the order of entries
+    std::sort(order.begin(), order.begin() + size,
+              [&](std::size_t lhs, std::size_t rhs) {
+                if (entries[lhs].first < entries[rhs].first) {
+                  return true;
+                }
+
+                if (entries[rhs].first < entries[lhs].first) {
+                  return false;
+                }
+
+                return lhs < rhs;
+              });
+
+    // report the duplicate which try_emplace of static_map would hit first
+    std::optional<duplicate_keys> duplicate;
+    for (std::size_t i = 1; i < size; ++i) {
+      if (entries[order[i - 1]].first == entries[order[i]].first
+          && (!duplicate.has_value() || order[i] < duplicate->second)) {
+        duplicate = duplicate_keys{.first = order[i - 1], .second = order[i]};
+      }
+    }
+
+    if (duplicate.has_value()) {
+      return unexpected{*duplicate};
+    }
+
+    frozen_static_map map;
+    for (std::size_t i = 0; i < size; ++i) {
+      map.data_[i] = entries[order[i]];
+    }
+    map.size_ = size;
+
+    return map;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] constexpr std::size_t max_size() const noexcept {
+    return MaxSize;
+  }
+
+  [[nodiscard]] constexpr const_iterator find(const Key& key) const noexcept {
+    const auto it = std::lower_bound(
+        begin(), end(), key,
+        [](const value_type& entry, const Key& k) { return entry.first < k; });
+    if (it == end() || !(it->first == key)) {
+      return end();
+    }
+
+    return it;
+  }
+
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return data_.begin();
+  }
+
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return data_.begin() + size_;
+  }
+
+ private:
+  container_type data_{};
+  std::size_t size_ = 0;
+};
+
 template<typename Key, typename Value, std::size_t MaxSize>
 class static_map {
   using Optional = std::optional<std::pair<const Key, Value>>;
@@ -63,6 +170,7 @@ class static_map {
   using container_type = std::array<Optional, MaxSize>;
   using iterator = details::_static_map::iterator_wrapper<typename container_type::iterator>;
   using const_iterator = details::_static_map::iterator_wrapper<typename container_type::const_iterator>;
+  using frozen_type = frozen_static_map<Key, Value, MaxSize>;
 
   constexpr static_map() = default;
 
@@ -127,6 +235,17 @@ class static_map {
     return std::default_sentinel;
   }
 
+  // sorted copy of the map with O(log N) lookups
+  [[nodiscard]] constexpr frozen_type freeze() const noexcept {
+    typename frozen_type::container_type entries{};
+    for (std::size_t i = 0; i < size_; ++i) {
+      entries[i] = *data_[i];
+    }
+
+    // keys of static_map are already unique
+    return frozen_type::make(entries, size_).value();
+  }
+
  private:
   std::array<std::optional<value_type>, MaxSize> data_{};
   std::size_t size_ = 0;
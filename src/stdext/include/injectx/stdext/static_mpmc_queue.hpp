@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/details/cache_line.hpp"
+#include "injectx/stdext/expected.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace injectx::stdext {
+
+// Bounded lock-free queue for any number of producers and consumers, the
+// concurrent counterpart of static_queue. Every slot has a sequence number
+// which tells whether it is ready to be written or read in the current lap,
+// so push and pop only contend on their own index. MaxSize is a power of two
+// to wrap indices with a mask. Values are stored in place, nothing is
+// allocated, every slot takes at least a cache line.
+//
+// A claimed slot has to be filled, otherwise consumers would wait for it
+// forever, so T is moved into and out of slots without throwing. A copy
+// is made before the slot is claimed.
+template<typename T, std::size_t MaxSize>
+  requires(std::has_single_bit(MaxSize))
+          && std::is_nothrow_move_constructible_v<T>
+class static_mpmc_queue {
+  static constexpr std::size_t mask = MaxSize - 1;
+
+  // a slot per cache line, so neighbouring slots written by a producer and
+  // read by a consumer at the same time do not share a line
+  struct alignas(details::cache_line_size) slot {
+    std::atomic<std::size_t> sequence;
+    // holds a value between a push and a pop of the same lap
+    alignas(T) std::byte storage[sizeof(T)];
+
+    [[nodiscard]] T* value() noexcept {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_mpmc_queue() noexcept {
+    for (std::size_t i = 0; i < MaxSize; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  static_mpmc_queue(const static_mpmc_queue&) = delete;
+  static_mpmc_queue& operator=(const static_mpmc_queue&) = delete;
+
+  ~static_mpmc_queue() {
+    while (pop().has_value()) {
+    }
+  }
+
+  expected<void, std::string_view> push(const T& value) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    T copy(value);
+    return emplace(std::move(copy));
+  }
+
+  expected<void, std::string_view> push(T&& value) noexcept {
+    return emplace(std::move(value));
+  }
+
+  expected<T, std::string_view> pop() noexcept {
+    auto position = head_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[position & mask];
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto lap = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+      if (lap == 0) {
+        if (head_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          T value = std::move(*slot.value());
+          std::destroy_at(slot.value());
+          slot.sequence.store(position + MaxSize, std::memory_order_release);
+          return value;
+        }
+      } else if (lap < 0) {
+        return unexpected{std::string_view{"queue is empty"}};
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // a snapshot, it could be stale by the time it is used
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // a snapshot, it could be stale by the time it is used
+  [[nodiscard]] std::size_t size() const noexcept {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  [[nodiscard]] constexpr std::size_t max_size() const noexcept {
+    return MaxSize;
+  }
+
+ private:
+  alignas(details::cache_line_size) std::array<slot, MaxSize> slots_;
+  alignas(details::cache_line_size) std::atomic<std::size_t> tail_{0};
+  alignas(details::cache_line_size) std::atomic<std::size_t> head_{0};
+
+  expected<void, std::string_view> emplace(T&& value) noexcept {
+    auto position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[position & mask];
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto lap = static_cast<std::ptrdiff_t>(sequence - position);
+
+      if (lap == 0) {
+        if (tail_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          ::new (static_cast<void*>(slot.storage)) T(std::move(value));
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return {};
+        }
+      } else if (lap < 0) {
+        return unexpected{std::string_view{"queue is full"}};
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+}  // namespace injectx::stdext
@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "injectx/stdext/coroutine.hpp"
+#include "injectx/stdext/details/cache_line.hpp"
+#include "injectx/stdext/expected.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace injectx::stdext {
+
+namespace details::_static_ring {
+
+// Holds the one coroutine which waits for a side of the ring. The waiter
+// stores itself before it checks the ring and the notifier updates the ring
+// before it checks the waiter, all sequentially consistent, so either the
+// waiter sees the new state or the notifier sees the waiter.
+class waiter {
+ public:
+  // false when ready() became true in the meantime and the coroutine should
+  // not suspend
+  template<typename Ready>
+  [[nodiscard]] bool park(
+      stdext::coroutine_handle<> handle, Ready&& ready) noexcept {
+    handle_.store(handle.address(), std::memory_order_seq_cst);
+    if (!ready()) {
+      return true;
+    }
+
+    // unless a notifier has already taken it to resume
+    return handle_.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+  }
+
+  void notify() noexcept {
+    if (handle_.load(std::memory_order_seq_cst) == nullptr) {
+      return;
+    }
+
+    if (auto* address = handle_.exchange(nullptr, std::memory_order_acq_rel)) {
+      stdext::coroutine_handle<>::from_address(address).resume();
+    }
+  }
+
+ private:
+  std::atomic<void*> handle_{nullptr};
+};
+
+template<typename Ring, bool (Ring::*Ready)() const noexcept>
+class awaiter {
+ public:
+  awaiter(const Ring& ring, waiter& waiter) noexcept
+      : ring_(&ring),
+        waiter_(&waiter) {
+  }
+
+  [[nodiscard]] bool await_ready() const noexcept {
+    return (ring_->*Ready)();
+  }
+
+  [[nodiscard]] bool await_suspend(
+      stdext::coroutine_handle<> handle) const noexcept {
+    // the awaiter lives in the frame, which could be already destroyed by
+    // the time ready() is called
+    return waiter_->park(handle, [ring = ring_] {
+      return (ring->*Ready)();
+    });
+  }
+
+  void await_resume() const noexcept {
+  }
+
+ private:
+  const Ring* ring_;
+  waiter* waiter_;
+};
+
+}  // namespace details::_static_ring
+
+// Bounded lock-free ring for exactly one producer and one consumer thread,
+// e.g. a stream between two modules. The producer and the consumer indices
+// live on separate cache lines and each side caches the other one's index,
+// so they only touch the shared lines when the cached view runs out.
+// Batches move a span of values with a single publication. MaxSize is a power
+// of two to wrap indices with a mask. Nothing is allocated.
+//
+// Either side could co_await until the ring is not empty or not full, a
+// suspended consumer is resumed on the producer thread by the push which
+// makes the ring non-empty and vice versa.
+template<typename T, std::size_t MaxSize>
+  requires(std::has_single_bit(MaxSize))
+class static_ring {
+  static constexpr std::size_t mask = MaxSize - 1;
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static_ring() = default;
+  static_ring(const static_ring&) = delete;
+  static_ring& operator=(const static_ring&) = delete;
+
+  // producer only
+  expected<void, std::string_view> push(const T& value) noexcept(
+      std::is_nothrow_copy_assignable_v<T>) {
+    return emplace(value);
+  }
+
+  // producer only
+  expected<void, std::string_view> push(T&& value) noexcept(
+      std::is_nothrow_move_assignable_v<T>) {
+    return emplace(std::move(value));
+  }
+
+  // producer only, copies as many values as fit and returns their number
+  std::size_t push(std::span<const T> values) noexcept(
+      std::is_nothrow_copy_assignable_v<T>) {
+    const auto tail = producer_.tail.load(std::memory_order_relaxed);
+    const auto count = std::min(values.size(), free_slots(tail, values.size()));
+    for (std::size_t i = 0; i < count; ++i) {
+      data_[(tail + i) & mask] = values[i];
+    }
+
+    if (count > 0) {
+      publish_tail(tail + count);
+    }
+
+    return count;
+  }
+
+  // consumer only
+  expected<T, std::string_view> pop() noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    const auto head = consumer_.head.load(std::memory_order_relaxed);
+    if (available(head, 1) == 0) {
+      return unexpected{std::string_view{"queue is empty"}};
+    }
+
+    T value = std::move(data_[head & mask]);
+    publish_head(head + 1);
+    return value;
+  }
+
+  // consumer only, moves up to values.size() values and returns their number
+  std::size_t pop(std::span<T> values) noexcept(
+      std::is_nothrow_move_assignable_v<T>) {
+    const auto head = consumer_.head.load(std::memory_order_relaxed);
+    const auto count = std::min(values.size(), available(head, values.size()));
+    for (std::size_t i = 0; i < count; ++i) {
+      values[i] = std::move(data_[(head + i) & mask]);
+    }
+
+    if (count > 0) {
+      publish_head(head + count);
+    }
+
+    return count;
+  }
+
+  // co_await suspends the consumer until the ring has a value
+  [[nodiscard]] auto wait_not_empty() noexcept {
+    return not_empty_awaiter{*this, consumerWaiter_};
+  }
+
+  // co_await suspends the producer until the ring has a free slot
+  [[nodiscard]] auto wait_not_full() noexcept {
+    return not_full_awaiter{*this, producerWaiter_};
+  }
+
+  // a snapshot, it could be stale by the time it is used
+  [[nodiscard]] std::size_t size() const noexcept {
+    // the head first, the tail could only be ahead of it
+    const auto head = consumer_.head.load(std::memory_order_acquire);
+    return producer_.tail.load(std::memory_order_acquire) - head;
+  }
+
+  // a snapshot, it could be stale by the time it is used
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  [[nodiscard]] constexpr std::size_t max_size() const noexcept {
+    return MaxSize;
+  }
+
+ private:
+  struct alignas(details::cache_line_size) producer_side {
+    std::atomic<std::size_t> tail{0};
+    std::size_t cachedHead{0};
+  };
+
+  struct alignas(details::cache_line_size) consumer_side {
+    std::atomic<std::size_t> head{0};
+    std::size_t cachedTail{0};
+  };
+
+  producer_side producer_;
+  consumer_side consumer_;
+  alignas(details::cache_line_size) details::_static_ring::waiter
+      producerWaiter_;
+  alignas(details::cache_line_size) details::_static_ring::waiter
+      consumerWaiter_;
+  alignas(details::cache_line_size) std::array<T, MaxSize> data_{};
+
+  // sequentially consistent with publish_tail and publish_head
+  [[nodiscard]] bool has_values() const noexcept {
+    return producer_.tail.load(std::memory_order_seq_cst)
+        != consumer_.head.load(std::memory_order_seq_cst);
+  }
+
+  [[nodiscard]] bool has_space() const noexcept {
+    return producer_.tail.load(std::memory_order_seq_cst)
+             - consumer_.head.load(std::memory_order_seq_cst)
+         < MaxSize;
+  }
+
+  using not_empty_awaiter =
+      details::_static_ring::awaiter<static_ring, &static_ring::has_values>;
+  using not_full_awaiter =
+      details::_static_ring::awaiter<static_ring, &static_ring::has_space>;
+
+  // free slots for the producer, refreshes the cached head only when it
+  // has less than wanted
+  [[nodiscard]] std::size_t free_slots(
+      std::size_t tail, std::size_t wanted) noexcept {
+    if (MaxSize - (tail - producer_.cachedHead) < wanted) {
+      producer_.cachedHead = consumer_.head.load(std::memory_order_acquire);
+    }
+
+    return MaxSize - (tail - producer_.cachedHead);
+  }
+
+  // values for the consumer, refreshes the cached tail only when it has
+  // less than wanted
+  [[nodiscard]] std::size_t available(
+      std::size_t head, std::size_t wanted) noexcept {
+    if (consumer_.cachedTail - head < wanted) {
+      consumer_.cachedTail = producer_.tail.load(std::memory_order_acquire);
+    }
+
+    return consumer_.cachedTail - head;
+  }
+
+  template<typename U>
+  expected<void, std::string_view> emplace(U&& value) {
+    const auto tail = producer_.tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0) {
+      return unexpected{std::string_view{"queue is full"}};
+    }
+
+    data_[tail & mask] = std::forward<U>(value);
+    publish_tail(tail + 1);
+    return {};
+  }
+
+  void publish_tail(std::size_t tail) noexcept {
+    producer_.tail.store(tail, std::memory_order_seq_cst);
+    consumerWaiter_.notify();
+  }
+
+  void publish_head(std::size_t head) noexcept {
+    consumer_.head.store(head, std::memory_order_seq_cst);
+    producerWaiter_.notify();
+  }
+};
+
+}  // namespace injectx::stdext
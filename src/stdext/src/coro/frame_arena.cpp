@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/frame_arena.hpp"
+
+#include "injectx/stdext/expects.hpp"
+
+#include <array>
+#include <new>
+#include <utility>
+
+namespace injectx::stdext::coro {
+
+namespace {
+
+constexpr std::size_t chunkMask = frame_arena::chunk_size - 1;
+
+// Every chunk starts with the arena it belongs to, the header keeps frames
+// aligned as the global operator new would.
+constexpr std::size_t headerSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(headerSize >= sizeof(frame_arena*));
+
+// Open addressing set of the chunks of every arena. A frame could be
+// destroyed on any thread, so lookups do not lock. An erased chunk leaves a
+// tombstone, which a later chunk reuses, an entry never becomes empty again.
+class chunk_registry {
+ public:
+  [[nodiscard]] bool insert(std::uintptr_t chunk) noexcept {
+    for (std::size_t i = 0; i < capacity; ++i) {
+      auto& entry = entries_[(hash(chunk) + i) & mask];
+      auto current = entry.load(std::memory_order_relaxed);
+      while (current == empty || current == erased) {
+        if (entry.compare_exchange_weak(
+                current, chunk, std::memory_order_release,
+                std::memory_order_relaxed)) {
+          size_.fetch_add(1, std::memory_order_release);
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void erase(std::uintptr_t chunk) noexcept {
+    for (std::size_t i = 0; i < capacity; ++i) {
+      auto& entry = entries_[(hash(chunk) + i) & mask];
+      if (entry.load(std::memory_order_relaxed) == chunk) {
+        entry.store(erased, std::memory_order_release);
+        size_.fetch_sub(1, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]] bool contains(std::uintptr_t chunk) const noexcept {
+    // no arena has memory, e.g. arenas are not used at all
+    if (size_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < capacity; ++i) {
+      const auto entry =
+          entries_[(hash(chunk) + i) & mask].load(std::memory_order_acquire);
+      if (entry == chunk) {
+        return true;
+      }
+
+      if (entry == empty) {
+        return false;
+      }
+    }
+
+    return false;
+  }
+
+ private:
+  // 256 MiB of chunks, the frames of a full registry come from the global
+  // operator new
+  static constexpr std::size_t capacityBits = 12;
+  static constexpr std::size_t capacity = std::size_t{1} << capacityBits;
+  static constexpr std::size_t mask = capacity - 1;
+
+  // chunks are aligned, so neither is a chunk address
+  static constexpr std::uintptr_t empty = 0;
+  static constexpr std::uintptr_t erased = 1;
+
+  std::atomic<std::size_t> size_{0};
+  std::array<std::atomic<std::uintptr_t>, capacity> entries_{};
+
+  [[nodiscard]] static std::size_t hash(std::uintptr_t chunk) noexcept {
+    const std::uint64_t index = chunk / frame_arena::chunk_size;
+    return static_cast<std::size_t>(
+        (index * 0x9E3779B97F4A7C15ULL) >> (64 - capacityBits));
+  }
+};
+
+constinit chunk_registry registry;
+
+// The chunk the calling thread bump-allocates from, a thread which switches
+// arenas starts a new chunk.
+struct local_chunk {
+  std::uint64_t arena{0};
+  std::byte* next{nullptr};
+  std::byte* end{nullptr};
+};
+
+thread_local frame_arena* currentArena{nullptr};
+thread_local local_chunk localChunk;
+
+std::atomic<std::uint64_t> nextArenaId{1};
+
+[[nodiscard]] std::uintptr_t chunk_of(void* frame) noexcept {
+  return reinterpret_cast<std::uintptr_t>(frame) & ~chunkMask;
+}
+
+}  // namespace
+
+frame_arena::scope::scope(frame_arena* arena) noexcept
+    : previous_(std::exchange(currentArena, arena)) {
+}
+
+frame_arena::scope::~scope() {
+  currentArena = previous_;
+}
+
+frame_arena::frame_arena() noexcept
+    : id_(nextArenaId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+frame_arena::~frame_arena() {
+  stdext::expects(
+      frames() == 0, "frame_arena destroyed with {} live frames", frames());
+
+  for (auto* chunk : chunks_) {
+    registry.erase(reinterpret_cast<std::uintptr_t>(chunk));
+    ::operator delete(chunk, std::align_val_t{chunk_size});
+  }
+}
+
+frame_arena* frame_arena::current() noexcept {
+  return currentArena;
+}
+
+void* frame_arena::allocate_frame(std::size_t size) {
+  auto* arena = currentArena;
+  if (arena == nullptr) {
+    return ::operator new(size);
+  }
+
+  constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+  size = (size + alignment - 1) & ~(alignment - 1);
+
+  std::byte* frame = nullptr;
+  if (size > chunk_size - headerSize) {
+    const auto blockSize = (headerSize + size + chunkMask) & ~chunkMask;
+    if (auto* block = arena->allocate_chunk(blockSize)) {
+      frame = block + headerSize;
+    }
+  } else {
+    auto& local = localChunk;
+    if (local.arena != arena->id_
+        || static_cast<std::size_t>(local.end - local.next) < size) {
+      if (auto* chunk = arena->allocate_chunk(chunk_size)) {
+        local = {arena->id_, chunk + headerSize, chunk + chunk_size};
+      }
+    }
+
+    if (local.arena == arena->id_
+        && static_cast<std::size_t>(local.end - local.next) >= size) {
+      frame = std::exchange(local.next, local.next + size);
+    }
+  }
+
+  if (frame == nullptr) {
+    return ::operator new(size);
+  }
+
+  arena->frames_.fetch_add(1, std::memory_order_relaxed);
+  return frame;
+}
+
+void frame_arena::deallocate_frame(void* frame) noexcept {
+  const auto chunk = chunk_of(frame);
+  if (!registry.contains(chunk)) {
+    ::operator delete(frame);
+    return;
+  }
+
+  auto* arena = *reinterpret_cast<frame_arena**>(chunk);
+  arena->frames_.fetch_sub(1, std::memory_order_release);
+}
+
+std::byte* frame_arena::allocate_chunk(std::size_t size) {
+  const std::lock_guard lock{mutex_};
+  // the only step which could throw once the chunk is allocated
+  if (chunks_.size() == chunks_.capacity()) {
+    chunks_.reserve(2 * chunks_.size() + 1);
+  }
+
+  auto* chunk = static_cast<std::byte*>(
+      ::operator new(size, std::align_val_t{chunk_size}));
+  *reinterpret_cast<frame_arena**>(chunk) = this;
+  if (!registry.insert(reinterpret_cast<std::uintptr_t>(chunk))) {
+    ::operator delete(chunk, std::align_val_t{chunk_size});
+    return nullptr;
+  }
+
+  chunks_.push_back(chunk);
+  return chunk;
+}
+
+}  // namespace injectx::stdext::coro
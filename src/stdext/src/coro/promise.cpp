@@ -3,6 +3,8 @@
 
 #include "injectx/stdext/coro/promise.hpp"
 
+#include "injectx/stdext/coro/frame_arena.hpp"
+
 namespace injectx::stdext::coro {
 
 bool resume_continuation::await_ready() const noexcept {
@@ -12,6 +14,15 @@ bool resume_continuation::await_ready() const noexcept {
 void resume_continuation::await_resume() const noexcept {
 }
 
+void* promise_continuation::operator new(std::size_t size) {
+  return frame_arena::allocate_frame(size);
+}
+
+void promise_continuation::operator delete(
+    void* frame, [[maybe_unused]] std::size_t size) noexcept {
+  frame_arena::deallocate_frame(frame);
+}
+
 stdext::suspend_always promise_continuation::initial_suspend() const noexcept {
   return {};
 }
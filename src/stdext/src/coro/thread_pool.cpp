@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace injectx::stdext::coro {
+
+namespace {
+
+struct current_worker {
+  const thread_pool* pool{nullptr};
+  std::size_t index{0};
+};
+
+thread_local current_worker currentWorker;
+
+}  // namespace
+
+thread_pool::thread_pool(std::size_t threads) {
+  threads = std::max<std::size_t>(1, threads);
+
+  queues_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<queue>());
+  }
+
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i] {
+      run(i);
+    });
+  }
+}
+
+thread_pool::~thread_pool() {
+  {
+    const std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool thread_pool::owns_current_thread() const noexcept {
+  return currentWorker.pool == this;
+}
+
+void thread_pool::enqueue(stdext::coroutine_handle<> handle) {
+  if (!owns_current_thread()) {
+    // counted before it is visible, so pending_ never goes below zero
+    pending_.fetch_add(1, std::memory_order_release);
+    if (!shared_.push(handle).has_value()) {
+      const std::lock_guard lock{mutex_};
+      overflow_.push_back(handle);
+    }
+  } else {
+    auto& local = *queues_[currentWorker.index];
+    const std::lock_guard lock{local.mutex};
+    local.handles.push_back(handle);
+    pending_.fetch_add(1, std::memory_order_release);
+  }
+
+  // an idle worker checks pending_ under mutex_ before it sleeps, taking the
+  // lock makes sure it either sees the new handle or gets the notification
+  { const std::lock_guard lock{mutex_}; }
+  cv_.notify_one();
+}
+
+stdext::coroutine_handle<> thread_pool::pop(std::size_t index) {
+  const auto take = [this](auto& handles, bool newest) {
+    if (handles.empty()) {
+      return stdext::coroutine_handle<>{};
+    }
+
+    stdext::coroutine_handle<> handle;
+    if (newest) {
+      handle = handles.back();
+      handles.pop_back();
+    } else {
+      handle = handles.front();
+      handles.pop_front();
+    }
+
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    return handle;
+  };
+
+  {
+    auto& local = *queues_[index];
+    const std::lock_guard lock{local.mutex};
+    if (auto handle = take(local.handles, true)) {
+      return handle;
+    }
+  }
+
+  if (auto handle = shared_.pop(); handle.has_value()) {
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    return handle.value();
+  }
+
+  {
+    const std::lock_guard lock{mutex_};
+    if (auto handle = take(overflow_, false)) {
+      return handle;
+    }
+  }
+
+  for (std::size_t i = 1; i < queues_.size(); ++i) {
+    auto& victim = *queues_[(index + i) % queues_.size()];
+    const std::lock_guard lock{victim.mutex};
+    if (auto handle = take(victim.handles, false)) {
+      return handle;
+    }
+  }
+
+  return {};
+}
+
+void thread_pool::run(std::size_t index) {
+  currentWorker = {.pool = this, .index = index};
+
+  while (true) {
+    if (auto handle = pop(index)) {
+      handle.resume();
+      continue;
+    }
+
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] {
+      return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+    });
+
+    if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+  }
+
+  currentWorker = {};
+}
+
+}  // namespace injectx::stdext::coro
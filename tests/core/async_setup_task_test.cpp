@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/async_setup_task.hpp"
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+#include "injectx/stdext/coro/when_all.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace injectx::core::tests {
+
+namespace {
+
+// resumes the awaiting coroutine on a new thread
+struct ResumeOnNewThread {
+  std::thread *thread;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(stdext::coroutine_handle<> handle) const {
+    *thread = std::thread{[handle] {
+      handle.resume();
+    }};
+  }
+
+  void await_resume() const noexcept {
+  }
+};
+
+stdext::coro::task<stdext::expected<int, std::string>> openShard(
+    stdext::coro::thread_pool &pool, int index) {
+  co_await pool.schedule();
+  if (index < 0) {
+    co_return stdext::unexpected{"shard " + std::to_string(index)};
+  }
+
+  co_return index;
+}
+
+}  // namespace
+
+TEST_CASE("concept") {
+  STATIC_REQUIRE(IsAsyncSetupTask<AsyncSetupTask<void>>);
+  STATIC_REQUIRE(IsAsyncSetupTask<SetupTask<void>> == false);
+  STATIC_REQUIRE(IsSetupTask<AsyncSetupTask<void>> == false);
+}
+
+TEST_CASE("init-and-teardown") {
+  struct Provides {
+    int value;
+  };
+
+  std::vector<std::string_view> steps;
+  auto setup = [](std::vector<std::string_view> &steps)
+      -> AsyncSetupTask<Provides> {
+    steps.push_back("start");
+    co_yield {.value = 10};
+    steps.push_back("teardown");
+  };
+
+  auto task = setup(steps);
+  REQUIRE(steps.empty());
+
+  const auto provides = stdext::coro::sync_wait(task.init());
+  REQUIRE(provides.has_value());
+  REQUIRE(provides->value == 10);
+  REQUIRE(steps == std::vector<std::string_view>{"start"});
+
+  REQUIRE(stdext::coro::sync_wait(task.teardown()).has_value());
+  REQUIRE(steps == std::vector<std::string_view>{"start", "teardown"});
+}
+
+TEST_CASE("co-await-on-other-thread") {
+  std::thread initThread;
+  std::thread teardownThread;
+
+  auto setup = [](std::thread &initThread,
+                  std::thread &teardownThread) -> AsyncSetupTask<void> {
+    co_await ResumeOnNewThread{&initThread};
+    co_yield {};
+    co_await ResumeOnNewThread{&teardownThread};
+  };
+
+  auto task = setup(initThread, teardownThread);
+  REQUIRE(stdext::coro::sync_wait(task.init()).has_value());
+  REQUIRE(initThread.joinable());
+
+  REQUIRE(stdext::coro::sync_wait(task.teardown()).has_value());
+  REQUIRE(teardownThread.joinable());
+
+  initThread.join();
+  teardownThread.join();
+}
+
+TEST_CASE("fan-out-in-init") {
+  struct Provides {
+    int shards;
+  };
+
+  stdext::coro::thread_pool pool{4};
+
+  auto setup = [](stdext::coro::thread_pool &pool,
+                  std::vector<int> indexes) -> AsyncSetupTask<Provides> {
+    std::vector<stdext::coro::task<stdext::expected<int, std::string>>>
+        shards;
+    for (const auto index : indexes) {
+      shards.push_back(openShard(pool, index));
+    }
+
+    auto opened = stdext::coro::collect(
+        co_await stdext::coro::when_all(std::move(shards)));
+    if (!opened.has_value()) {
+      co_yield stdext::unexpected{std::move(opened).error()};
+    }
+
+    co_yield {.shards = std::accumulate(opened->begin(), opened->end(), 0)};
+  };
+
+  SECTION("all-opened") {
+    auto task = setup(pool, {1, 2, 3, 4});
+    const auto provides = stdext::coro::sync_wait(task.init());
+    REQUIRE(provides.has_value());
+    REQUIRE(provides->shards == 10);
+    REQUIRE(stdext::coro::sync_wait(task.teardown()).has_value());
+  }
+
+  SECTION("one-failed") {
+    auto task = setup(pool, {1, -2, 3, -4});
+    const auto provides = stdext::coro::sync_wait(task.init());
+    REQUIRE(provides.has_value() == false);
+    REQUIRE(provides.error() == "shard -2");
+  }
+}
+
+TEST_CASE("init-missing-co-yield") {
+  auto setup = []() -> AsyncSetupTask<void> {
+    co_return;
+  };
+
+  auto task = setup();
+  const auto res = stdext::coro::sync_wait(task.init());
+  REQUIRE(res.has_value() == false);
+  REQUIRE(res.error() == std::string_view{"SetupTask is missing co_yield"});
+  REQUIRE(stdext::coro::sync_wait(task.teardown()).has_value());
+}
+
+TEST_CASE("init-error") {
+  auto setup = []() -> AsyncSetupTask<void> {
+    co_yield stdext::unexpected{"failed"};
+  };
+
+  auto task = setup();
+  const auto res = stdext::coro::sync_wait(task.init());
+  REQUIRE(res.has_value() == false);
+  REQUIRE(res.error() == std::string_view{"failed"});
+}
+
+TEST_CASE("init-twice") {
+  auto setup = []() -> AsyncSetupTask<void> {
+    co_yield {};
+  };
+
+  auto task = setup();
+  REQUIRE(stdext::coro::sync_wait(task.init()).has_value());
+
+  const auto res = stdext::coro::sync_wait(task.init());
+  REQUIRE(res.has_value() == false);
+  REQUIRE(
+      res.error() == std::string_view{"SetupTask has been already inialized"});
+}
+
+TEST_CASE("teardown-before-init") {
+  auto setup = []() -> AsyncSetupTask<void> {
+    co_yield {};
+  };
+
+  auto task = setup();
+  const auto res = stdext::coro::sync_wait(task.teardown());
+  REQUIRE(res.has_value() == false);
+  REQUIRE(
+      res.error()
+      == std::string_view{"SetupTask task has not been inialized yet"});
+}
+
+TEST_CASE("co-yield-twice") {
+  auto setup = []() -> AsyncSetupTask<void> {
+    co_yield {};
+    co_yield {};
+  };
+
+  auto task = setup();
+  REQUIRE(stdext::coro::sync_wait(task.init()).has_value());
+
+  const auto res = stdext::coro::sync_wait(task.teardown());
+  REQUIRE(res.has_value() == false);
+  REQUIRE(
+      res.error()
+      == std::string_view{"SetupTask co_yield twice with Provides{}"});
+}
+
+}  // namespace injectx::core::tests
@@ -5,6 +5,11 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
 namespace injectx::core::tests {
 
 namespace modules::first {
@@ -78,6 +83,22 @@ TEST_CASE("constexpr-order") {
   STATIC_REQUIRE(bundle->at(2).name() == std::string_view{"second"});
 }
 
+TEST_CASE("constexpr-graph") {
+  constexpr auto bundle = makeBundle<
+      modules::second::setup, modules::first::setup, modules::third::setup>();
+
+  STATIC_REQUIRE(bundle.has_value());
+  STATIC_REQUIRE(bundle->dependencies(0).empty());
+  STATIC_REQUIRE(bundle->dependencies(1).empty());
+  STATIC_REQUIRE(bundle->dependencies(2).size() == 1);
+  STATIC_REQUIRE(bundle->dependencies(2)[0] == 1);
+
+  STATIC_REQUIRE(bundle->dependents(0).empty());
+  STATIC_REQUIRE(bundle->dependents(1).size() == 1);
+  STATIC_REQUIRE(bundle->dependents(1)[0] == 2);
+  STATIC_REQUIRE(bundle->dependents(2).empty());
+}
+
 namespace modules::forth {
 
 struct Provides {
@@ -102,4 +123,161 @@ TEST_CASE("conflict") {
           "Dependency 'value' provided by two modules 'third' and 'forth'"});
 }
 
+namespace modules::ping {
+
+struct Requires {
+  int pong;
+};
+
+struct Provides {
+  int ping;
+};
+
+SetupTask<Provides> setup(Requires) {
+  co_yield {.ping = 1};
+}
+
+}  // namespace modules::ping
+
+namespace modules::pong {
+
+struct Requires {
+  int ping;
+};
+
+struct Provides {
+  int pong;
+};
+
+SetupTask<Provides> setup(Requires) {
+  co_yield {.pong = 1};
+}
+
+}  // namespace modules::pong
+
+TEST_CASE("constexpr-circular-dependencies") {
+  constexpr auto bundle = makeBundle<
+      modules::third::setup, modules::ping::setup, modules::pong::setup>();
+
+  STATIC_REQUIRE(bundle.has_value() == false);
+  STATIC_REQUIRE(bundle.error() == std::string_view{"circular dependencies"});
+}
+
+namespace modules::pair {
+
+struct Provides {
+  int left;
+  int right;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {.left = 1, .right = 2};
+}
+
+}  // namespace modules::pair
+
+namespace modules::sum {
+
+struct Requires {
+  int left;
+  int right;
+  int value;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield {};
+}
+
+}  // namespace modules::sum
+
+}  // namespace injectx::core::tests
+
+template<>
+inline constexpr std::chrono::nanoseconds
+    injectx::core::setupCost<injectx::core::tests::modules::pair::setup> =
+        std::chrono::milliseconds{2};
+
+template<>
+inline constexpr std::chrono::nanoseconds
+    injectx::core::setupCost<injectx::core::tests::modules::sum::setup> =
+        std::chrono::milliseconds{3};
+
+namespace injectx::core::tests {
+
+TEST_CASE("constexpr-several-fields-of-one-provider") {
+  constexpr auto bundle = makeBundle<
+      modules::sum::setup, modules::pair::setup, modules::third::setup>();
+
+  STATIC_REQUIRE(bundle.has_value());
+  STATIC_REQUIRE(bundle->at(0).name() == std::string_view{"pair"});
+  STATIC_REQUIRE(bundle->at(1).name() == std::string_view{"third"});
+  STATIC_REQUIRE(bundle->at(2).name() == std::string_view{"sum"});
+
+  STATIC_REQUIRE(bundle->dependencies(2).size() == 2);
+  STATIC_REQUIRE(bundle->dependencies(2)[0] == 0);
+  STATIC_REQUIRE(bundle->dependencies(2)[1] == 1);
+  STATIC_REQUIRE(bundle->dependents(0).size() == 1);
+  STATIC_REQUIRE(bundle->dependents(0)[0] == 2);
+}
+
+TEST_CASE("constexpr-levels") {
+  constexpr auto bundle = makeBundle<
+      modules::sum::setup, modules::pair::setup, modules::third::setup,
+      modules::first::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+  STATIC_REQUIRE(bundle->at(3).name() == std::string_view{"sum"});
+
+  STATIC_REQUIRE(bundle->levels() == 2);
+
+  STATIC_REQUIRE(bundle->level(0).size() == 3);
+  STATIC_REQUIRE(bundle->level(0)[0] == 0);
+  STATIC_REQUIRE(bundle->level(0)[1] == 1);
+  STATIC_REQUIRE(bundle->level(0)[2] == 2);
+  STATIC_REQUIRE(bundle->level(1).size() == 1);
+  STATIC_REQUIRE(bundle->level(1)[0] == 3);
+
+  STATIC_REQUIRE(bundle->levelOf(0) == 0);
+  STATIC_REQUIRE(bundle->levelOf(3) == 1);
+}
+
+TEST_CASE("constexpr-critical-path") {
+  using std::chrono::milliseconds;
+
+  constexpr auto bundle = makeBundle<
+      modules::sum::setup, modules::pair::setup, modules::third::setup,
+      modules::first::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+
+  // pair -> sum is the longest chain of costs
+  STATIC_REQUIRE(bundle->criticalPath() == milliseconds{5});
+  STATIC_REQUIRE(bundle->remainingCost(0) == milliseconds{5});
+  STATIC_REQUIRE(bundle->remainingCost(1) == milliseconds{3});
+  STATIC_REQUIRE(bundle->remainingCost(2) == milliseconds{0});
+  STATIC_REQUIRE(bundle->remainingCost(3) == milliseconds{3});
+
+  // third -> sum becomes the longest one
+  const std::array costs{milliseconds{1}, milliseconds{4}};
+  const std::vector<std::chrono::nanoseconds> runtime{
+      costs.begin(), costs.end()};
+  const auto remaining = bundle->remainingCosts(runtime);
+  REQUIRE(remaining.size() == 4);
+  REQUIRE(remaining[0] == milliseconds{4});
+  REQUIRE(remaining[1] == milliseconds{7});
+  REQUIRE(remaining[3] == milliseconds{3});
+}
+
+TEST_CASE("constexpr-provider") {
+  constexpr auto bundle = makeBundle<
+      modules::sum::setup, modules::pair::setup, modules::third::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+
+  STATIC_REQUIRE(bundle->provider({.type = "int", .name = "left"}) == 0);
+  STATIC_REQUIRE(bundle->provider({.type = "int", .name = "right"}) == 0);
+  STATIC_REQUIRE(bundle->provider({.type = "int", .name = "value"}) == 1);
+  STATIC_REQUIRE(!bundle->provider({.type = "float", .name = "value"}));
+
+  const std::string name{"right"};
+  REQUIRE(bundle->provider({.type = "int", .name = name}) == 0);
+}
+
 }  // namespace injectx::core::tests
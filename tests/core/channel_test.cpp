@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/channel.hpp"
+
+#include "injectx/core/bundle.hpp"
+#include "injectx/core/launch.hpp"
+#include "injectx/stdext/coro/latch.hpp"
+#include "injectx/stdext/coro/spawn.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <string_view>
+#include <utility>
+
+namespace injectx::core::tests {
+
+namespace modules::pool {
+
+struct Provides {
+  stdext::coro::thread_pool *pool;
+};
+
+SetupTask<Provides> setup() {
+  stdext::coro::thread_pool pool{2};
+  co_yield {.pool = &pool};
+}
+
+}  // namespace modules::pool
+
+namespace modules::producer {
+
+struct Requires {
+  stdext::coro::thread_pool *pool;
+  Channel<int, 4> numbers;
+};
+
+struct Provides {
+  Channel<int, 4> numbers;
+};
+
+stdext::coro::task<void> produce(
+    stdext::coro::thread_pool &pool, Channel<int, 4> numbers, int count) {
+  co_await pool.schedule();
+  for (int i = 1; i <= count; ++i) {
+    while (!numbers->push(i).has_value()) {
+      co_await numbers->wait_not_full();
+    }
+  }
+}
+
+AsyncSetupTask<Provides> setup(Requires deps) {
+  // a named object, GCC 12 destroys a braced temporary of co_yield twice
+  Provides provides{.numbers = deps.numbers};
+  stdext::coro::latch produced{1};
+  stdext::coro::spawn(
+      produce(*deps.pool, provides.numbers, 10), [&produced] {
+        produced.count_down();
+      });
+
+  co_yield std::move(provides);
+  co_await produced;
+}
+
+}  // namespace modules::producer
+
+namespace modules::forgetful_producer {
+
+struct Provides {
+  Channel<int, 4> numbers;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {};
+}
+
+}  // namespace modules::forgetful_producer
+
+namespace modules::swapping_producer {
+
+struct Requires {
+  Channel<int, 4> numbers;
+};
+
+struct Provides {
+  Channel<int, 4> numbers;
+};
+
+SetupTask<Provides> setup(Requires) {
+  Provides provides{.numbers = Channel<int, 4>::make()};
+  co_yield std::move(provides);
+}
+
+}  // namespace modules::swapping_producer
+
+namespace modules::consumer {
+
+std::atomic<int> gSum{0};
+
+struct Requires {
+  Channel<int, 4> numbers;
+};
+
+AsyncSetupTask<void> setup(Requires deps) {
+  int sum = 0;
+  for (int received = 0; received < 10;) {
+    if (const auto value = deps.numbers->pop(); value.has_value()) {
+      sum += value.value();
+      ++received;
+    } else {
+      co_await deps.numbers->wait_not_empty();
+    }
+  }
+
+  gSum = sum;
+  co_yield {};
+}
+
+}  // namespace modules::consumer
+
+namespace modules::second_consumer {
+
+struct Requires {
+  Channel<int, 4> numbers;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield {};
+}
+
+}  // namespace modules::second_consumer
+
+namespace modules::wide_consumer {
+
+struct Requires {
+  Channel<int, 8> numbers;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield {};
+}
+
+}  // namespace modules::wide_consumer
+
+TEST_CASE("concept") {
+  STATIC_REQUIRE(IsChannel<Channel<int>>);
+  STATIC_REQUIRE(IsChannel<const Channel<int, 4> &>);
+  STATIC_REQUIRE(IsChannel<int> == false);
+  STATIC_REQUIRE(Channel<int>::capacity() == 64);
+}
+
+TEST_CASE("make") {
+  Channel<int, 2> unbound;
+  REQUIRE(!unbound);
+
+  auto channel = Channel<int, 2>::make();
+  REQUIRE(channel);
+  REQUIRE(channel != Channel<int, 2>::make());
+
+  const auto copy = channel;
+  REQUIRE(copy == channel);
+  REQUIRE(channel->push(1).has_value());
+  REQUIRE(copy->pop().value() == 1);
+  REQUIRE((*copy).empty());
+}
+
+TEST_CASE("manifest") {
+  constexpr auto producer = makeManifest<modules::producer::setup>();
+  STATIC_REQUIRE(producer->provides().size() == 1);
+  STATIC_REQUIRE(producer->provides()[0].channel);
+  STATIC_REQUIRE(producer->dependencies()[0].channel == false);
+  STATIC_REQUIRE(producer->dependencies()[1] == producer->provides()[0]);
+
+  constexpr auto consumer = makeManifest<modules::consumer::setup>();
+  STATIC_REQUIRE(consumer->dependencies()[0].channel);
+  STATIC_REQUIRE(consumer->dependencies()[0] == producer->provides()[0]);
+}
+
+TEST_CASE("bundle") {
+  constexpr auto bundle = makeBundle<
+      modules::consumer::setup, modules::producer::setup,
+      modules::pool::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+  STATIC_REQUIRE(bundle->at(2).name() == "consumer");
+
+  SECTION("not-required-by-producer") {
+    constexpr auto broken = makeBundle<
+        modules::consumer::setup, modules::forgetful_producer::setup>();
+    STATIC_REQUIRE(broken.has_value() == false);
+    STATIC_REQUIRE(
+        broken.error()
+        == std::string_view{
+            "Channel 'numbers' provided by 'forgetful_producer' is not "
+            "required by it"});
+  }
+
+  SECTION("no-consumer") {
+    constexpr auto broken =
+        makeBundle<modules::producer::setup, modules::pool::setup>();
+    STATIC_REQUIRE(broken.has_value() == false);
+    STATIC_REQUIRE(
+        broken.error()
+        == std::string_view{
+            "Channel 'numbers' provided by 'producer' has no consumer"});
+  }
+
+  SECTION("two-consumers") {
+    constexpr auto broken = makeBundle<
+        modules::consumer::setup, modules::second_consumer::setup,
+        modules::producer::setup, modules::pool::setup>();
+    STATIC_REQUIRE(broken.has_value() == false);
+    STATIC_REQUIRE(
+        broken.error()
+        == std::string_view{
+            "Channel 'numbers' provided by 'producer' is consumed by two "
+            "modules 'consumer' and 'second_consumer'"});
+  }
+
+  SECTION("capacity-mismatch") {
+    constexpr auto broken = makeBundle<
+        modules::wide_consumer::setup, modules::producer::setup,
+        modules::pool::setup>();
+    STATIC_REQUIRE(broken.has_value() == false);
+    STATIC_REQUIRE(
+        broken.error().starts_with(
+            "Component 'wide_consumer' could not resolve dependency"));
+  }
+}
+
+TEST_CASE("launch-pipeline") {
+  constexpr auto bundle = makeBundle<
+      modules::consumer::setup, modules::producer::setup,
+      modules::pool::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+
+  for (const std::size_t threads : {1, 2}) {
+    modules::consumer::gSum = 0;
+
+    auto t = launch(bundle.value(), {.threads = threads});
+    REQUIRE(t.init().has_value());
+    REQUIRE(modules::consumer::gSum == 55);
+    REQUIRE(t.teardown().has_value());
+  }
+}
+
+TEST_CASE("launch-other-channel") {
+  constexpr auto bundle = makeBundle<
+      modules::consumer::setup, modules::swapping_producer::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+
+  auto t = launch(bundle.value());
+  const auto res = t.init();
+  REQUIRE(res.has_value() == false);
+  REQUIRE(
+      res.error()
+      == std::string_view{
+          "Channel 'injectx::core::Channel<int, 4> numbers' is not the one "
+          "from Requires"});
+  REQUIRE(t.teardown().has_value());
+}
+
+}  // namespace injectx::core::tests
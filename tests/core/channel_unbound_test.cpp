@@ -0,0 +1,11 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/channel.hpp"
+
+#include <cstdlib>
+
+int main() {
+  const injectx::core::Channel<int, 2> channel;
+  return channel->push(1).has_value() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
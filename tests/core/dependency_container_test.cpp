@@ -5,7 +5,34 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cstdlib>
 #include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::size_t gAllocations{};
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  ++gAllocations;
+  if (auto *p = std::malloc(size); p != nullptr) {
+    return p;
+  }
+
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  std::free(p);
+}
 
 namespace injectx::core::tests {
 
@@ -49,7 +76,7 @@ TEST_CASE("provide-pod-types") {
 namespace second {
 
 struct Provides {
-  std::function<int()> value;
+  Factory<int> value;
 };
 
 struct Requires {
@@ -78,6 +105,28 @@ TEST_CASE("provide-callable") {
   REQUIRE(resolved->value == 1);
 }
 
+TEST_CASE("resolve-factory") {
+  using namespace second;
+
+  DependencyContainer dependencies;
+
+  int value = 10;
+  REQUIRE(dependencies
+              .provide(Provides{.value = [&value] {
+                return value++;
+              }})
+              .has_value());
+
+  const auto resolved = dependencies.resolve<Provides>();
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->value() == 10);
+  REQUIRE(resolved->value() == 11);
+
+  const auto resolvedValue = dependencies.resolve<Requires>();
+  REQUIRE(resolvedValue.has_value());
+  REQUIRE(resolvedValue->value == 12);
+}
+
 namespace third {
 
 struct Provides {
@@ -105,6 +154,32 @@ TEST_CASE("provide-shared-pointer") {
   REQUIRE(provides.value.use_count() == 3);
 }
 
+namespace third {
+
+struct RequiresRef {
+  Ref<std::shared_ptr<int>> value;
+};
+
+}  // namespace third
+
+TEST_CASE("resolve-by-reference") {
+  using namespace third;
+
+  DependencyContainer dependencies;
+
+  Provides provides{.value = std::make_shared<int>(100)};
+  REQUIRE(dependencies.provide(provides).has_value());
+  REQUIRE(provides.value.use_count() == 2);
+
+  const auto resolved1 = dependencies.resolve<RequiresRef>();
+  const auto resolved2 = dependencies.resolve<RequiresRef>();
+  REQUIRE(resolved1.has_value());
+  REQUIRE(resolved2.has_value());
+  REQUIRE(*resolved1->value.get() == 100);
+  REQUIRE(&resolved1->value.get() == &resolved2->value.get());
+  REQUIRE(provides.value.use_count() == 2);
+}
+
 namespace forth {
 
 struct Provides {
@@ -237,4 +312,125 @@ TEST_CASE("provide-conflictig-types") {
       == std::string_view{"Dependency 'float f' has not been provided"});
 }
 
+namespace eight {
+
+struct Provides {
+  int id;
+  std::shared_ptr<int> value;
+  std::vector<int> values;
+};
+
+struct Requires {
+  Ref<std::vector<int>> values;
+};
+
+}  // namespace eight
+
+TEST_CASE("provide-by-move") {
+  using namespace eight;
+
+  DependencyContainer dependencies;
+
+  const auto value = std::make_shared<int>(7);
+  Provides provides{.id = 1, .value = value, .values = {1, 2, 3}};
+  const auto *data = provides.values.data();
+  REQUIRE(dependencies.provide(std::move(provides)).has_value());
+  REQUIRE(value.use_count() == 2);
+
+  const auto resolved = dependencies.resolve<Requires>();
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->values->data() == data);
+}
+
+TEST_CASE("provide-by-move-twice") {
+  using namespace eight;
+
+  DependencyContainer dependencies;
+
+  REQUIRE(dependencies
+              .provide(Provides{
+                  .id = 1, .value = std::make_shared<int>(1), .values = {1}})
+              .has_value());
+
+  Provides provides{
+      .id = 2, .value = std::make_shared<int>(2), .values = {2}};
+  const auto provided = dependencies.provide(std::move(provides));
+  REQUIRE(provided.has_value() == false);
+  REQUIRE(
+      provided.error()
+      == std::string_view{"Dependency 'int id' has been already provided"});
+
+  REQUIRE(provides.value != nullptr);
+  REQUIRE(*provides.value == 2);
+  REQUIRE(provides.values == std::vector{2});
+}
+
+namespace nine {
+
+struct Provides {
+  std::unique_ptr<int> value;
+};
+
+struct Requires {
+  Ref<std::unique_ptr<int>> value;
+};
+
+}  // namespace nine
+
+TEST_CASE("provide-move-only") {
+  using namespace nine;
+
+  DependencyContainer dependencies;
+
+  auto value = std::make_unique<int>(42);
+  const auto *address = value.get();
+  REQUIRE(dependencies.provide(Provides{.value = std::move(value)})
+              .has_value());
+
+  const auto resolved = dependencies.resolve<Requires>();
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->value->get() == address);
+  REQUIRE(**resolved->value == 42);
+}
+
+TEST_CASE("resolve-does-not-allocate") {
+  using namespace first;
+
+  DependencyContainer dependencies;
+  REQUIRE(dependencies.provide(Provides{.i = 5, .b = true, .f = 1.5})
+              .has_value());
+
+  const auto allocations = gAllocations;
+  const auto resolved = dependencies.resolve<Requires>();
+  REQUIRE(gAllocations == allocations);
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->i == 5);
+}
+
+TEST_CASE("small-values-are-inline") {
+  using details::_dependency_container::Value;
+
+  struct Large {
+    std::array<int, 16> values;
+  };
+
+  auto shared = std::make_shared<int>(7);
+  const auto allocations = gAllocations;
+  Value small{42};
+  Value pointer{shared};
+  REQUIRE(gAllocations == allocations);
+
+  Value large{Large{.values = {1, 2}}};
+  REQUIRE(gAllocations == allocations + 1);
+
+  const Value moved{std::move(pointer)};
+  REQUIRE(pointer.get<std::shared_ptr<int>>() == nullptr);
+  REQUIRE(**moved.get<std::shared_ptr<int>>() == 7);
+  REQUIRE(shared.use_count() == 2);
+
+  REQUIRE(*small.get<int>() == 42);
+  REQUIRE(small.get<long>() == nullptr);
+  REQUIRE(large.get<Large>()->values[1] == 2);
+}
+
 }  // namespace injectx::core::tests
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/dependency_index.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace injectx::core::tests {
+
+namespace impl = details::_dependency_index;
+
+TEST_CASE("fingerprint") {
+  constexpr DependencyInfo info{.type = "int", .name = "value"};
+  constexpr DependencyInfo same{.type = "int", .name = "value"};
+  constexpr DependencyInfo shifted{.type = "intv", .name = "alue"};
+
+  STATIC_REQUIRE(info.fingerprint == same.fingerprint);
+  STATIC_REQUIRE(info == same);
+  STATIC_REQUIRE(info.fingerprint != shifted.fingerprint);
+  STATIC_REQUIRE(info != shifted);
+}
+
+TEST_CASE("empty") {
+  using Entries = std::array<std::pair<DependencyInfo, std::size_t>, 0>;
+  static constexpr auto storage = impl::BuildFn<0>{}(Entries{}).value();
+  constexpr auto index = storage.view();
+  constexpr DependencyInfo info{.type = "int", .name = "value"};
+
+  STATIC_REQUIRE(index.find(info).has_value() == false);
+  STATIC_REQUIRE(DependencyIndex{}.find(info).has_value() == false);
+}
+
+TEST_CASE("find") {
+  static constexpr auto storage = std::invoke([] {
+    std::array<std::pair<DependencyInfo, std::size_t>, 64> entries{};
+    constexpr std::array types{"int", "float", "double", "long"};
+    constexpr std::array names{
+        "a", "b", "c", "d", "e", "f", "g", "h",
+        "i", "j", "k", "l", "m", "n", "o", "p"};
+
+    std::size_t index{};
+    for (const auto type : types) {
+      for (const auto name : names) {
+        entries[index] = {DependencyInfo{.type = type, .name = name}, index};
+        ++index;
+      }
+    }
+
+    return impl::BuildFn<entries.size()>{}(entries).value();
+  });
+  constexpr auto index = storage.view();
+
+  STATIC_REQUIRE(index.find({.type = "int", .name = "a"}) == 0);
+  STATIC_REQUIRE(index.find({.type = "int", .name = "p"}) == 15);
+  STATIC_REQUIRE(index.find({.type = "float", .name = "a"}) == 16);
+  STATIC_REQUIRE(index.find({.type = "long", .name = "p"}) == 63);
+  STATIC_REQUIRE(!index.find({.type = "long", .name = "q"}).has_value());
+  STATIC_REQUIRE(!index.find({.type = "char", .name = "a"}).has_value());
+
+  const std::string type{"double"};
+  const std::string name{"c"};
+  REQUIRE(index.find({.type = type, .name = name}) == 34);
+}
+
+}  // namespace injectx::core::tests
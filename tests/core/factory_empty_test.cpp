@@ -0,0 +1,11 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/factory.hpp"
+
+#include <cstdlib>
+
+int main() {
+  const injectx::core::Factory<int> factory;
+  return factory() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
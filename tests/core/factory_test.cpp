@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/factory.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace injectx::core::tests {
+
+int answer() {
+  return 42;
+}
+
+TEST_CASE("function-pointer") {
+  const Factory<int> factory = &answer;
+  REQUIRE(factory() == 42);
+}
+
+TEST_CASE("stateful-lambda") {
+  int calls = 0;
+  const Factory<std::string> factory = [&calls] {
+    return std::to_string(++calls);
+  };
+
+  REQUIRE(factory() == "1");
+  REQUIRE(factory() == "2");
+
+  const auto copy = factory;
+  REQUIRE(copy() == "3");
+  REQUIRE(calls == 3);
+}
+
+TEST_CASE("compact") {
+  STATIC_REQUIRE(std::is_trivially_copyable_v<Factory<int>>);
+  STATIC_REQUIRE(sizeof(Factory<int>) == 3 * sizeof(void *));
+
+  STATIC_REQUIRE(IsFactory<Factory<int>>);
+  STATIC_REQUIRE(IsFactory<const Factory<int> &>);
+  STATIC_REQUIRE_FALSE(IsFactory<int>);
+
+  STATIC_REQUIRE(std::is_same_v<FactoryValueType<Factory<int>>, int>);
+  STATIC_REQUIRE(std::is_same_v<FactoryValueType<int>, int>);
+
+  // not trivially copyable or does not fit into the inline storage
+  const auto shared = [p = std::make_shared<int>(1)] {
+    return *p;
+  };
+  const auto large = [a = 1, b = 2, c = 3, d = 4, e = 5] {
+    return a + b + c + d + e;
+  };
+  STATIC_REQUIRE_FALSE(std::is_constructible_v<Factory<int>, decltype(shared)>);
+  STATIC_REQUIRE_FALSE(std::is_constructible_v<Factory<int>, decltype(large)>);
+}
+
+}  // namespace injectx::core::tests
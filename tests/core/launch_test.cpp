@@ -5,6 +5,14 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace injectx::core::tests {
 
 namespace modules::first {
@@ -28,4 +36,456 @@ TEST_CASE("constexpr-success") {
   REQUIRE(t.teardown().has_value());
 }
 
+namespace modules::producer {
+
+std::vector<int> gSteps;
+
+struct Provides {
+  int value;
+  std::vector<int> *steps;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {.value = 42, .steps = &gSteps};
+  gSteps.push_back(2);
+}
+
+}  // namespace modules::producer
+
+namespace modules::consumer {
+
+struct Requires {
+  int value;
+  std::vector<int> *steps;
+};
+
+SetupTask<void> setup(Requires deps) {
+  deps.steps->push_back(deps.value);
+  co_yield {};
+  deps.steps->push_back(1);
+}
+
+}  // namespace modules::consumer
+
+TEST_CASE("dependencies") {
+  constexpr auto bundle =
+      makeBundle<modules::consumer::setup, modules::producer::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &steps = modules::producer::gSteps;
+  steps.clear();
+
+  auto dependencyContainer = bundle->makeDependencyContainer();
+  auto producer = bundle->at(0).setup(dependencyContainer);
+  REQUIRE(producer.init().has_value());
+
+  auto consumer = bundle->at(1).setup(dependencyContainer);
+  REQUIRE(consumer.init().has_value());
+  REQUIRE(steps == std::vector{42});
+
+  REQUIRE(consumer.teardown().has_value());
+  REQUIRE(producer.teardown().has_value());
+  REQUIRE(steps == std::vector{42, 1, 2});
+}
+
+TEST_CASE("launch-dependencies") {
+  constexpr auto bundle =
+      makeBundle<modules::consumer::setup, modules::producer::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &steps = modules::producer::gSteps;
+  steps.clear();
+
+  auto t = launch(bundle.value());
+  REQUIRE(t.init().has_value());
+  REQUIRE(steps == std::vector{42});
+  REQUIRE(t.teardown().has_value());
+  REQUIRE(steps.size() == 3);
+}
+
+struct Events {
+  std::mutex mutex;
+  std::vector<std::string> items;
+
+  void push(std::string item) {
+    const std::lock_guard lock{mutex};
+    items.push_back(std::move(item));
+  }
+
+  std::size_t indexOf(std::string_view item) {
+    const auto it = std::find(items.begin(), items.end(), item);
+    REQUIRE(it != items.end());
+    return static_cast<std::size_t>(std::distance(items.begin(), it));
+  }
+};
+
+namespace modules::events {
+
+Events gEvents;
+
+struct Provides {
+  Events *events;
+};
+
+SetupTask<Provides> setup() {
+  gEvents.push("init events");
+  co_yield {.events = &gEvents};
+  gEvents.push("teardown events");
+}
+
+}  // namespace modules::events
+
+namespace modules::left {
+
+struct Requires {
+  Events *events;
+};
+
+struct Provides {
+  int left;
+};
+
+SetupTask<Provides> setup(Requires deps) {
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  deps.events->push("init left");
+  co_yield {.left = 1};
+  deps.events->push("teardown left");
+}
+
+}  // namespace modules::left
+
+namespace modules::right {
+
+struct Requires {
+  Events *events;
+};
+
+struct Provides {
+  int right;
+};
+
+SetupTask<Provides> setup(Requires deps) {
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  deps.events->push("init right");
+  co_yield {.right = 2};
+  deps.events->push("teardown right");
+}
+
+}  // namespace modules::right
+
+namespace modules::top {
+
+struct Requires {
+  Events *events;
+  int left;
+  int right;
+};
+
+SetupTask<void> setup(Requires deps) {
+  deps.events->push(fmt::format("init top {}", deps.left + deps.right));
+  co_yield {};
+  deps.events->push("teardown top");
+}
+
+}  // namespace modules::top
+
+TEST_CASE("launch-parallel") {
+  constexpr auto bundle = makeBundle<
+      modules::top::setup, modules::right::setup, modules::left::setup,
+      modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  for (const std::size_t threads : {1, 2, 8}) {
+    auto &events = modules::events::gEvents;
+    events.items.clear();
+
+    auto t = launch(bundle.value(), {.threads = threads});
+    REQUIRE(t.init().has_value());
+    REQUIRE(events.items.size() == 4);
+    REQUIRE(events.items.front() == "init events");
+    REQUIRE(events.items.back() == "init top 3");
+
+    REQUIRE(t.teardown().has_value());
+    REQUIRE(events.items.size() == 8);
+    REQUIRE(events.items[4] == "teardown top");
+    REQUIRE(events.items.back() == "teardown events");
+    REQUIRE(
+        events.indexOf("teardown left") < events.indexOf("teardown events"));
+    REQUIRE(
+        events.indexOf("teardown right") < events.indexOf("teardown events"));
+  }
+}
+
+TEST_CASE("launch-costs") {
+  constexpr auto bundle = makeBundle<
+      modules::top::setup, modules::right::setup, modules::left::setup,
+      modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+  STATIC_REQUIRE(bundle->at(1).name() == std::string_view{"right"});
+  STATIC_REQUIRE(bundle->at(2).name() == std::string_view{"left"});
+
+  auto &events = modules::events::gEvents;
+
+  SECTION("bundle-order") {
+    events.items.clear();
+    auto t = launch(bundle.value());
+    REQUIRE(t.init().has_value());
+    REQUIRE(events.indexOf("init right") < events.indexOf("init left"));
+    REQUIRE(t.teardown().has_value());
+  }
+
+  SECTION("slow-module-first") {
+    using namespace std::chrono_literals;
+    const std::array<std::chrono::nanoseconds, 4> costs{0ms, 1ms, 5ms, 0ms};
+
+    events.items.clear();
+    auto t = launch(bundle.value(), {.costs = costs});
+    REQUIRE(t.init().has_value());
+    REQUIRE(events.indexOf("init left") < events.indexOf("init right"));
+    REQUIRE(t.teardown().has_value());
+  }
+}
+
+namespace modules::warmer {
+
+struct Requires {
+  Events *events;
+};
+
+SetupTask<void> setup(Requires deps) {
+  deps.events->push("init warmer");
+  co_yield {};
+}
+
+}  // namespace modules::warmer
+
+}  // namespace injectx::core::tests
+
+template<>
+inline constexpr std::chrono::nanoseconds
+    injectx::core::setupCost<injectx::core::tests::modules::warmer::setup> =
+        std::chrono::milliseconds{100};
+
+namespace injectx::core::tests {
+
+TEST_CASE("launch-static-costs") {
+  constexpr auto bundle = makeBundle<
+      modules::top::setup, modules::right::setup, modules::left::setup,
+      modules::warmer::setup, modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+  STATIC_REQUIRE(bundle->at(3).name() == std::string_view{"warmer"});
+  STATIC_REQUIRE(bundle->at(3).cost() == std::chrono::milliseconds{100});
+  STATIC_REQUIRE(bundle->at(1).cost() == std::chrono::nanoseconds{0});
+
+  auto &events = modules::events::gEvents;
+  events.items.clear();
+
+  auto t = launch(bundle.value());
+  REQUIRE(t.init().has_value());
+  REQUIRE(events.items[1] == "init warmer");
+  REQUIRE(t.teardown().has_value());
+}
+
+namespace modules::broken {
+
+struct Requires {
+  int left;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield stdext::unexpected{"broken init"};
+}
+
+}  // namespace modules::broken
+
+TEST_CASE("launch-parallel-error") {
+  constexpr auto bundle = makeBundle<
+      modules::broken::setup, modules::top::setup, modules::right::setup,
+      modules::left::setup, modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &events = modules::events::gEvents;
+  events.items.clear();
+
+  auto t = launch(bundle.value(), {.threads = 4});
+  const auto res = t.init();
+  REQUIRE(res.has_value() == false);
+  REQUIRE(res.error() == std::string_view{"broken init"});
+
+  REQUIRE(t.teardown().has_value());
+  REQUIRE(events.items.back() == "teardown events");
+}
+
+// resumes the awaiting coroutine on a new thread, as an I/O completion would
+struct ResumeOnNewThread {
+  std::thread *thread;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(stdext::coroutine_handle<> handle) const {
+    *thread = std::thread{[handle] {
+      handle.resume();
+    }};
+  }
+
+  void await_resume() const noexcept {
+  }
+};
+
+namespace modules::loader {
+
+std::thread gThread;
+
+struct Requires {
+  Events *events;
+};
+
+struct Provides {
+  int loaded;
+};
+
+AsyncSetupTask<Provides> setup(Requires deps) {
+  co_await ResumeOnNewThread{&gThread};
+  deps.events->push("init loader");
+  co_yield {.loaded = 3};
+  deps.events->push("teardown loader");
+}
+
+}  // namespace modules::loader
+
+namespace modules::reader {
+
+struct Requires {
+  Events *events;
+  int loaded;
+};
+
+SetupTask<void> setup(Requires deps) {
+  deps.events->push(fmt::format("init reader {}", deps.loaded));
+  co_yield {};
+  deps.events->push("teardown reader");
+}
+
+}  // namespace modules::reader
+
+TEST_CASE("launch-async") {
+  constexpr auto bundle = makeBundle<
+      modules::reader::setup, modules::loader::setup,
+      modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &events = modules::events::gEvents;
+  auto &thread = modules::loader::gThread;
+
+  for (const std::size_t threads : {1, 2}) {
+    events.items.clear();
+
+    auto t = launch(bundle.value(), {.threads = threads});
+    REQUIRE(t.init().has_value());
+    thread.join();
+    REQUIRE(
+        events.items
+        == std::vector<std::string>{
+            "init events", "init loader", "init reader 3"});
+
+    REQUIRE(t.teardown().has_value());
+    REQUIRE(events.items.size() == 6);
+    REQUIRE(events.items[3] == "teardown reader");
+    REQUIRE(events.items[4] == "teardown loader");
+  }
+
+  SECTION("sync-setup") {
+    events.items.clear();
+
+    auto dependencyContainer = bundle->makeDependencyContainer();
+    std::vector<SetupTask<void>> tasks;
+    for (const auto &module : bundle.value()) {
+      tasks.push_back(module.setup(dependencyContainer));
+      REQUIRE(tasks.back().init().has_value());
+    }
+
+    thread.join();
+    REQUIRE(events.items.back() == "init reader 3");
+
+    for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+      REQUIRE(it->teardown().has_value());
+    }
+
+    REQUIRE(events.items.back() == "teardown events");
+  }
+}
+
+TEST_CASE("launch-executor") {
+  constexpr auto bundle = makeBundle<
+      modules::top::setup, modules::right::setup, modules::left::setup,
+      modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &events = modules::events::gEvents;
+  events.items.clear();
+
+  stdext::coro::thread_pool pool{2};
+  auto t = launch(bundle.value(), {.executor = &pool});
+  REQUIRE(t.init().has_value());
+  REQUIRE(events.items.size() == 4);
+  REQUIRE(events.items.back() == "init top 3");
+
+  REQUIRE(t.teardown().has_value());
+  REQUIRE(events.items.size() == 8);
+  REQUIRE(events.items[4] == "teardown top");
+  REQUIRE(events.items.back() == "teardown events");
+
+  SECTION("error") {
+    constexpr auto broken = makeBundle<
+        modules::broken::setup, modules::top::setup, modules::right::setup,
+        modules::left::setup, modules::events::setup>();
+    STATIC_REQUIRE(broken.has_value() == true);
+
+    events.items.clear();
+    auto b = launch(broken.value(), {.executor = &pool});
+    const auto res = b.init();
+    REQUIRE(res.has_value() == false);
+    REQUIRE(res.error() == std::string_view{"broken init"});
+
+    REQUIRE(b.teardown().has_value());
+    REQUIRE(events.items.back() == "teardown events");
+  }
+
+  SECTION("destroyed-after-teardown") {
+    // the last completion returns on a worker while the launch is destroyed
+    for (int i = 0; i < 100; ++i) {
+      events.items.clear();
+      auto again = launch(bundle.value(), {.executor = &pool});
+      REQUIRE(again.init().has_value());
+      REQUIRE(again.teardown().has_value());
+    }
+
+    REQUIRE(events.items.size() == 8);
+  }
+}
+
+TEST_CASE("launch-frame-arena") {
+  constexpr auto bundle = makeBundle<
+      modules::top::setup, modules::right::setup, modules::left::setup,
+      modules::events::setup>();
+  STATIC_REQUIRE(bundle.has_value() == true);
+
+  auto &events = modules::events::gEvents;
+  events.items.clear();
+
+  stdext::coro::frame_arena arena;
+  {
+    auto t = launch(bundle.value(), {.threads = 2, .frameArena = &arena});
+    REQUIRE(t.init().has_value());
+    REQUIRE(arena.frames() >= bundle->size());
+
+    REQUIRE(t.teardown().has_value());
+    REQUIRE(events.items.size() == 8);
+  }
+
+  REQUIRE(arena.frames() == 0);
+}
+
 }  // namespace injectx::core::tests
@@ -150,4 +150,27 @@ TEST_CASE("error-depends-on-itself") {
       == std::string_view{"Component 'boo' provides and depends on 'foo'"});
 }
 
+namespace modules::factory {
+
+struct Provides {
+  Factory<int> counter;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {.counter = [] {
+    return 1;
+  }};
+}
+
+}  // namespace modules::factory
+
+TEST_CASE("provides-factory") {
+  constexpr auto manifest = makeManifest<modules::factory::setup>();
+  STATIC_REQUIRE(manifest.has_value());
+
+  constexpr std::array provides = {
+      DependencyInfo{.type = "int", .name = "counter"}};
+  STATIC_REQUIRE(manifest->provides() == gsl::span{provides});
+}
+
 }  // namespace injectx::core::tests
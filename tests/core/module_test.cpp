@@ -231,4 +231,58 @@ TEST_CASE("only-requires") {
   REQUIRE(t.init().has_value());
 }
 
+namespace modules::seven {
+
+struct Pool {
+  explicit Pool(int size)
+      : size(size) {
+  }
+
+  Pool(const Pool &) = delete;
+  Pool(Pool &&) = default;
+
+  int size;
+};
+
+struct Provides {
+  std::unique_ptr<Pool> pool;
+};
+
+SetupTask<Provides> setup() {
+  Provides provides{.pool = std::make_unique<Pool>(4)};
+  co_yield std::move(provides);
+}
+
+struct Requires {
+  Ref<std::unique_ptr<Pool>> pool;
+};
+
+int gSize{};
+
+SetupTask<void> consumer(Requires deps) {
+  gSize = (*deps.pool)->size;
+  co_yield {};
+}
+
+}  // namespace modules::seven
+
+TEST_CASE("move-only-dependency") {
+  DependencyContainer dependencyContainer;
+
+  constexpr auto producer = makeModule<modules::seven::setup>();
+  STATIC_REQUIRE(producer.has_value());
+  constexpr auto consumer = makeModule<modules::seven::consumer>();
+  STATIC_REQUIRE(consumer.has_value());
+
+  auto producerTask = producer->setup(dependencyContainer);
+  REQUIRE(producerTask.init().has_value());
+
+  auto consumerTask = consumer->setup(dependencyContainer);
+  REQUIRE(consumerTask.init().has_value());
+  REQUIRE(modules::seven::gSize == 4);
+
+  REQUIRE(consumerTask.teardown().has_value());
+  REQUIRE(producerTask.teardown().has_value());
+}
+
 }  // namespace injectx::core::tests
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/ref.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <type_traits>
+
+namespace injectx::core::tests {
+
+TEST_CASE("value-type") {
+  STATIC_REQUIRE(IsRef<Ref<int>>);
+  STATIC_REQUIRE(IsRef<const Ref<int> &>);
+  STATIC_REQUIRE_FALSE(IsRef<int>);
+  STATIC_REQUIRE_FALSE(IsRef<std::shared_ptr<int>>);
+
+  STATIC_REQUIRE(std::is_same_v<RefValueType<Ref<int>>, int>);
+  STATIC_REQUIRE(std::is_same_v<RefValueType<int>, int>);
+}
+
+TEST_CASE("refers-to-value") {
+  const auto value = std::make_shared<int>(10);
+  const Ref ref{value};
+
+  REQUIRE(&ref.get() == &value);
+  REQUIRE(&*ref == &value);
+  REQUIRE(*ref->get() == 10);
+  REQUIRE(value.use_count() == 1);
+
+  STATIC_REQUIRE_FALSE(std::is_constructible_v<Ref<int>, int>);
+  STATIC_REQUIRE_FALSE(std::is_convertible_v<const int &, Ref<int>>);
+}
+
+}  // namespace injectx::core::tests
@@ -1,10 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2023 Mikhail Svetkin
 // SPDX-License-Identifier: MIT
 
+#include "injectx/core/ref.hpp"
 #include "injectx/core/setup_concepts.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <memory>
 #include <type_traits>
 
 namespace injectx::core::tests {
@@ -83,4 +85,36 @@ TEST_CASE("as-concept-with-auto-template-argument") {
   STATIC_REQUIRE(IsSetupVariable<onlyRequires>);
 }
 
+struct MoveOnly {
+  std::unique_ptr<int> value;
+};
+
+SetupTask<MoveOnly> providesMoveOnly() {
+  co_yield {};
+}
+
+TEST_CASE("provides-move-only") {
+  STATIC_REQUIRE(IsSetupFunction<decltype(providesMoveOnly)>);
+}
+
+SetupTask<void> requiresMoveOnly(MoveOnly) {
+  co_yield {};
+}
+
+TEST_CASE("requires-move-only") {
+  STATIC_REQUIRE_FALSE(IsSetupFunction<decltype(requiresMoveOnly)>);
+}
+
+struct MoveOnlyRef {
+  Ref<std::unique_ptr<int>> value;
+};
+
+SetupTask<void> requiresMoveOnlyRef(MoveOnlyRef) {
+  co_yield {};
+}
+
+TEST_CASE("requires-move-only-by-reference") {
+  STATIC_REQUIRE(IsSetupFunction<decltype(requiresMoveOnlyRef)>);
+}
+
 }  // namespace injectx::core::tests
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/startup_profile.hpp"
+
+#include "injectx/core/launch.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace injectx::core::tests {
+
+using namespace std::chrono_literals;
+
+namespace modules::first {
+
+struct Provides {
+  int value;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {.value = 1};
+}
+
+}  // namespace modules::first
+
+namespace modules::slow {
+
+std::vector<std::string> gSteps;
+
+struct Provides {
+  int delay;
+};
+
+SetupTask<Provides> setup() {
+  std::this_thread::sleep_for(5ms);
+  gSteps.emplace_back("slow");
+  co_yield {.delay = 5};
+}
+
+}  // namespace modules::slow
+
+namespace modules::second {
+
+struct Requires {
+  int value;
+};
+
+SetupTask<void> setup(Requires) {
+  modules::slow::gSteps.emplace_back("second");
+  co_yield {};
+}
+
+}  // namespace modules::second
+
+TEST_CASE("serialize") {
+  StartupProfile profile;
+  profile.set("first", {.init = 10ms, .teardown = 1ms});
+  profile.set("second", {.init = 3ns, .teardown = 0ns});
+
+  const auto data = profile.serialize();
+  REQUIRE(data.substr(0, 4) == "IXSP");
+
+  const auto loaded = StartupProfile::deserialize(data);
+  REQUIRE(loaded.has_value());
+  REQUIRE(loaded->size() == 2);
+  REQUIRE(loaded->find("first") == StartupProfile::Timings{10ms, 1ms});
+  REQUIRE(loaded->find("second") == StartupProfile::Timings{3ns, 0ns});
+  REQUIRE(loaded->find("third").has_value() == false);
+}
+
+TEST_CASE("deserialize-errors") {
+  REQUIRE(
+      StartupProfile::deserialize("XXXX").error()
+      == "Invalid startup profile: bad magic");
+
+  StartupProfile profile;
+  profile.set("first", {.init = 10ms, .teardown = 1ms});
+  const auto data = profile.serialize();
+
+  REQUIRE(
+      StartupProfile::deserialize(data.substr(0, data.size() - 1)).error()
+      == "Invalid startup profile: truncated");
+  REQUIRE(
+      StartupProfile::deserialize(data + "x").error()
+      == "Invalid startup profile: trailing data");
+}
+
+TEST_CASE("regressions") {
+  StartupProfile baseline;
+  baseline.set("first", {.init = 10ms, .teardown = 1ms});
+  baseline.set("second", {.init = 10us, .teardown = 0ns});
+
+  StartupProfile current;
+  current.set("first", {.init = 31ms, .teardown = 1ms});
+  current.set("second", {.init = 100us, .teardown = 0ns});
+  current.set("third", {.init = 100ms, .teardown = 0ns});
+
+  const auto regressions = current.regressions(baseline, 3.0);
+  REQUIRE(regressions.size() == 1);
+  REQUIRE(regressions[0].module == "first");
+  REQUIRE(regressions[0].phase == LaunchPhase::init);
+  REQUIRE(regressions[0].baseline == 10ms);
+  REQUIRE(regressions[0].current == 31ms);
+
+  REQUIRE(current.regressions(current).empty());
+}
+
+TEST_CASE("launch-profile") {
+  constexpr auto bundle = makeBundle<
+      modules::second::setup, modules::first::setup, modules::slow::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+  STATIC_REQUIRE(bundle->at(0).name() == std::string_view{"first"});
+  STATIC_REQUIRE(bundle->at(1).name() == std::string_view{"slow"});
+
+  auto &steps = modules::slow::gSteps;
+  const auto path =
+      std::filesystem::temp_directory_path() / "injectx-startup-profile.bin";
+
+  {
+    steps.clear();
+    StartupProfile profile;
+    auto t = launch(bundle.value(), {.profile = &profile});
+    REQUIRE(t.init().has_value());
+    REQUIRE(t.teardown().has_value());
+    REQUIRE(steps == std::vector<std::string>{"slow", "second"});
+
+    REQUIRE(profile.size() == 3);
+    REQUIRE(profile.find("slow")->init >= 5ms);
+    REQUIRE(profile.save(path).has_value());
+  }
+
+  {
+    // a slow second puts first and second ahead of slow
+    steps.clear();
+    auto profile = StartupProfile::load(path);
+    REQUIRE(profile.has_value());
+    profile->set("second", {.init = 1s, .teardown = 0ns});
+
+    auto t = launch(bundle.value(), {.profile = &profile.value()});
+    REQUIRE(t.init().has_value());
+    REQUIRE(t.teardown().has_value());
+    REQUIRE(steps == std::vector<std::string>{"second", "slow"});
+    REQUIRE(profile->find("second")->init < 1s);
+  }
+
+  std::filesystem::remove(path);
+  REQUIRE(StartupProfile::load(path).has_value() == false);
+}
+
+}  // namespace injectx::core::tests
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/static_dependency_container.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+namespace injectx::core::tests {
+
+namespace first {
+
+struct Provides {
+  int i;
+  bool b;
+};
+
+}  // namespace first
+
+namespace second {
+
+struct Provides {
+  float f;
+  std::shared_ptr<int> p;
+};
+
+struct Requires {
+  std::shared_ptr<int> p;
+  int i;
+};
+
+}  // namespace second
+
+using Container = StaticDependencyContainer<first::Provides, second::Provides>;
+
+TEST_CASE("provide-and-resolve") {
+  Container dependencies;
+
+  REQUIRE(dependencies.provide(first::Provides{.i = 5, .b = true}).has_value());
+  REQUIRE(dependencies
+              .provide(second::Provides{
+                  .f = 1.5, .p = std::make_shared<int>(100)})
+              .has_value());
+
+  const auto resolved = dependencies.resolve<second::Requires>();
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->i == 5);
+  REQUIRE(*resolved->p == 100);
+
+  const auto first = dependencies.resolve<first::Provides>();
+  REQUIRE(first.has_value());
+  REQUIRE(first->i == 5);
+  REQUIRE(first->b == true);
+}
+
+TEST_CASE("provide-twice") {
+  Container dependencies;
+
+  REQUIRE(dependencies.provide(first::Provides{.i = 5, .b = true}).has_value());
+
+  const auto provided =
+      dependencies.provide(first::Provides{.i = 6, .b = false});
+  REQUIRE(provided.has_value() == false);
+  REQUIRE(
+      provided.error()
+      == std::string_view{"Dependency 'int i' has been already provided"});
+
+  const auto resolved = dependencies.resolve<first::Provides>();
+  REQUIRE(resolved.has_value());
+  REQUIRE(resolved->i == 5);
+}
+
+namespace second {
+
+struct RequiresRef {
+  Ref<std::shared_ptr<int>> p;
+  Ref<int> i;
+};
+
+}  // namespace second
+
+TEST_CASE("resolve-by-reference") {
+  Container dependencies;
+
+  const auto p = std::make_shared<int>(100);
+  REQUIRE(dependencies.provide(first::Provides{.i = 5, .b = true}).has_value());
+  REQUIRE(dependencies.provide(second::Provides{.f = 1.5, .p = p}).has_value());
+  REQUIRE(p.use_count() == 2);
+
+  const auto resolved1 = dependencies.resolve<second::RequiresRef>();
+  const auto resolved2 = dependencies.resolve<second::RequiresRef>();
+  REQUIRE(resolved1.has_value());
+  REQUIRE(resolved2.has_value());
+  REQUIRE(resolved1->i.get() == 5);
+  REQUIRE(resolved1->p.get() == p);
+  REQUIRE(&resolved1->p.get() == &resolved2->p.get());
+  REQUIRE(&resolved1->i.get() == &resolved2->i.get());
+  REQUIRE(p.use_count() == 2);
+}
+
+namespace third {
+
+struct Requires {
+  int i;
+  double d;
+};
+
+}  // namespace third
+
+TEST_CASE("resolve-missing") {
+  Container dependencies;
+
+  const auto resolved = dependencies.resolve<second::Requires>();
+  REQUIRE(resolved.has_value() == false);
+  REQUIRE(
+      resolved.error()
+      == std::string_view{"Dependencies 'std::shared_ptr<int> p' has not been "
+                          "provided, 'int i' has not been provided"});
+
+  REQUIRE(dependencies.provide(first::Provides{.i = 5, .b = true}).has_value());
+
+  const auto unknown = dependencies.resolve<third::Requires>();
+  REQUIRE(unknown.has_value() == false);
+  REQUIRE(
+      unknown.error()
+      == std::string_view{"Dependency 'double d' has not been provided"});
+}
+
+namespace forth {
+
+struct Provides {
+  Factory<int> counter;
+};
+
+struct Requires {
+  int counter;
+};
+
+}  // namespace forth
+
+TEST_CASE("resolve-factory") {
+  StaticDependencyContainer<forth::Provides> dependencies;
+
+  int counter = 0;
+  REQUIRE(dependencies
+              .provide(forth::Provides{.counter = [&counter] {
+                return ++counter;
+              }})
+              .has_value());
+
+  const auto first = dependencies.resolve<forth::Requires>();
+  REQUIRE(first.has_value());
+  REQUIRE(first->counter == 1);
+
+  const auto second = dependencies.resolve<forth::Requires>();
+  REQUIRE(second.has_value());
+  REQUIRE(second->counter == 2);
+
+  const auto factory = dependencies.resolve<forth::Provides>();
+  REQUIRE(factory.has_value());
+  REQUIRE(factory->counter() == 3);
+}
+
+TEST_CASE("provide-by-move") {
+  Container dependencies;
+
+  const auto p = std::make_shared<int>(100);
+  second::Provides provides{.f = 1.5, .p = p};
+  REQUIRE(dependencies.provide(std::move(provides)).has_value());
+  REQUIRE(provides.p == nullptr);
+  REQUIRE(p.use_count() == 2);
+
+  second::Provides again{.f = 2.5, .p = std::make_shared<int>(200)};
+  const auto provided = dependencies.provide(std::move(again));
+  REQUIRE(provided.has_value() == false);
+  REQUIRE(again.p != nullptr);
+  REQUIRE(*again.p == 200);
+}
+
+}  // namespace injectx::core::tests
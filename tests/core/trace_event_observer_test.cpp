@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/core/trace_event_observer.hpp"
+
+#include "injectx/core/launch.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+
+namespace injectx::core::tests {
+
+namespace modules::first {
+
+struct Provides {
+  int value;
+};
+
+SetupTask<Provides> setup() {
+  co_yield {.value = 1};
+}
+
+}  // namespace modules::first
+
+namespace modules::second {
+
+struct Requires {
+  int value;
+};
+
+SetupTask<void> setup(Requires) {
+  co_yield {};
+}
+
+}  // namespace modules::second
+
+TEST_CASE("launch-events") {
+  constexpr auto bundle =
+      makeBundle<modules::second::setup, modules::first::setup>();
+  STATIC_REQUIRE(bundle.has_value());
+
+  TraceEventObserver observer;
+  auto t = launch(bundle.value(), {.observer = &observer});
+  REQUIRE(t.init().has_value());
+  REQUIRE(t.teardown().has_value());
+
+  const auto events = observer.events();
+  const auto has = [&events](std::string_view module, LaunchPhase phase) {
+    return std::ranges::any_of(events, [&](const auto &event) {
+      return event.module == module && event.phase == phase;
+    });
+  };
+
+  REQUIRE(events.size() == 6);
+  REQUIRE(has("first", LaunchPhase::init));
+  REQUIRE(has("first", LaunchPhase::provide));
+  REQUIRE(has("first", LaunchPhase::teardown));
+  REQUIRE(has("second", LaunchPhase::init));
+  REQUIRE(has("second", LaunchPhase::resolve));
+  REQUIRE(has("second", LaunchPhase::teardown));
+  REQUIRE_FALSE(has("first", LaunchPhase::resolve));
+}
+
+TEST_CASE("chrome-trace-json") {
+  TraceEventObserver observer;
+  REQUIRE(observer.toJson() == R"({"traceEvents":[],"displayTimeUnit":"ms"})");
+
+  const auto start = LaunchEvent::Clock::now();
+  observer.onEvent({
+      .module = "first",
+      .phase = LaunchPhase::init,
+      .start = start,
+      .duration = std::chrono::microseconds{1500},
+      .thread = std::this_thread::get_id(),
+  });
+
+  const auto json = observer.toJson();
+  REQUIRE(json.starts_with(R"({"traceEvents":[{"name":"first","cat":"init",)"));
+  REQUIRE(json.find(R"("ph":"X")") != std::string::npos);
+  REQUIRE(json.find(R"("dur":1500.000,"pid":1,"tid":1})") != std::string::npos);
+}
+
+}  // namespace injectx::core::tests
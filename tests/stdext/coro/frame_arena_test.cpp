@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/frame_arena.hpp"
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/generator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace injectx::stdext::coro::tests {
+
+namespace {
+
+task<int> value(int v) {
+  co_return v;
+}
+
+task<int> sum(int lhs, int rhs) {
+  co_return co_await value(lhs) + co_await value(rhs);
+}
+
+generator<int> count(int n) {
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+}  // namespace
+
+TEST_CASE("scope") {
+  frame_arena arena;
+  REQUIRE(frame_arena::current() == nullptr);
+
+  {
+    const frame_arena::scope scope{&arena};
+    REQUIRE(frame_arena::current() == &arena);
+
+    {
+      const frame_arena::scope nested{nullptr};
+      REQUIRE(frame_arena::current() == nullptr);
+    }
+
+    REQUIRE(frame_arena::current() == &arena);
+  }
+
+  REQUIRE(frame_arena::current() == nullptr);
+}
+
+TEST_CASE("task") {
+  frame_arena arena;
+
+  SECTION("without-scope") {
+    auto t = value(1);
+    REQUIRE(arena.frames() == 0);
+    REQUIRE(sync_wait(t) == 1);
+  }
+
+  SECTION("with-scope") {
+    std::optional<task<int>> t;
+    {
+      const frame_arena::scope scope{&arena};
+      t.emplace(sum(1, 2));
+    }
+    REQUIRE(arena.frames() == 1);
+
+    // nested frames are created while the task runs, outside of the scope
+    REQUIRE(sync_wait(*t) == 3);
+    REQUIRE(arena.frames() == 1);
+
+    t.reset();
+    REQUIRE(arena.frames() == 0);
+  }
+
+  SECTION("destroyed-on-other-thread") {
+    std::optional<task<int>> t;
+    {
+      const frame_arena::scope scope{&arena};
+      t.emplace(value(1));
+    }
+
+    std::thread{[&t] {
+      t.reset();
+    }}.join();
+    REQUIRE(arena.frames() == 0);
+  }
+}
+
+TEST_CASE("parallel") {
+  frame_arena arena;
+
+  std::atomic<int> wrong{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&arena, &wrong] {
+      const frame_arena::scope scope{&arena};
+      for (int j = 0; j < 1000; ++j) {
+        auto t = sum(j, 1);
+        if (sync_wait(t) != j + 1) {
+          ++wrong;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(wrong == 0);
+  REQUIRE(arena.frames() == 0);
+}
+
+TEST_CASE("large-frame") {
+  frame_arena arena;
+
+  {
+    const frame_arena::scope scope{&arena};
+    auto* frame = frame_arena::allocate_frame(2 * frame_arena::chunk_size);
+    REQUIRE(arena.frames() == 1);
+    frame_arena::deallocate_frame(frame);
+  }
+
+  REQUIRE(arena.frames() == 0);
+}
+
+TEST_CASE("generator") {
+  frame_arena arena;
+
+  {
+    const frame_arena::scope scope{&arena};
+    auto gen = count(3);
+    REQUIRE(arena.frames() == 1);
+
+    int total = 0;
+    for (const auto i : gen) {
+      total += i;
+    }
+    REQUIRE(total == 3);
+  }
+
+  REQUIRE(arena.frames() == 0);
+}
+
+}  // namespace injectx::stdext::coro::tests
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/latch.hpp"
+
+#include "injectx/stdext/coro/spawn.hpp"
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+
+namespace injectx::stdext::coro::tests {
+
+TEST_CASE("ready") {
+  latch done{0};
+  REQUIRE(done.is_ready());
+  sync_wait(done);
+
+  latch negative{-1};
+  REQUIRE(negative.is_ready());
+}
+
+TEST_CASE("count-down") {
+  latch done{2};
+  int resumed{0};
+
+  spawn(done, [&resumed] {
+    ++resumed;
+  });
+  spawn(done, [&resumed] {
+    ++resumed;
+  });
+
+  done.count_down();
+  REQUIRE(done.is_ready() == false);
+  REQUIRE(resumed == 0);
+
+  done.count_down();
+  REQUIRE(done.is_ready());
+  REQUIRE(resumed == 2);
+
+  // awaited after the release
+  spawn(done, [&resumed] {
+    ++resumed;
+  });
+  REQUIRE(resumed == 3);
+}
+
+TEST_CASE("count-down-n") {
+  latch done{3};
+  done.count_down(3);
+  REQUIRE(done.is_ready());
+}
+
+TEST_CASE("parallel") {
+  constexpr int count = 1000;
+
+  std::atomic<int> finished{0};
+  latch done{count};
+
+  {
+    thread_pool pool{4};
+    for (int i = 0; i < count; ++i) {
+      spawn(pool.schedule(), [&] {
+        finished.fetch_add(1);
+        done.count_down();
+      });
+    }
+
+    sync_wait(done);
+    REQUIRE(finished.load() == count);
+  }
+}
+
+}  // namespace injectx::stdext::coro::tests
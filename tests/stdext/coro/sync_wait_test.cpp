@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+
+#include "injectx/stdext/coro/task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace injectx::stdext::coro::tests {
+
+namespace {
+
+// resumes the awaiting coroutine on a new thread
+struct ResumeOnNewThread {
+  std::thread *thread;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(stdext::coroutine_handle<> handle) const {
+    *thread = std::thread{[handle] {
+      handle.resume();
+    }};
+  }
+
+  void await_resume() const noexcept {
+  }
+};
+
+}  // namespace
+
+TEST_CASE("ready-awaiter") {
+  int value{0};
+  sync_wait(stdext::suspend_never{});
+  spawn(stdext::suspend_never{}, [&value] {
+    value = 1;
+  });
+
+  REQUIRE(value == 1);
+}
+
+TEST_CASE("task") {
+  auto t = std::invoke([]() -> task<int> {
+    co_return 42;
+  });
+
+  REQUIRE(sync_wait(t) == 42);
+}
+
+TEST_CASE("move-only-result") {
+  auto t = std::invoke([]() -> task<std::unique_ptr<int>> {
+    co_return std::make_unique<int>(42);
+  });
+
+  const auto res = sync_wait(t);
+  REQUIRE(res != nullptr);
+  REQUIRE(*res == 42);
+}
+
+TEST_CASE("resumed-on-other-thread") {
+  std::thread thread;
+  std::thread::id resumedOn;
+
+  auto t = std::invoke(
+      [](std::thread &thread, std::thread::id &resumedOn) -> task<void> {
+        co_await ResumeOnNewThread{&thread};
+        resumedOn = std::this_thread::get_id();
+      },
+      thread, resumedOn);
+
+  sync_wait(t);
+  REQUIRE(thread.joinable());
+  REQUIRE(resumedOn == thread.get_id());
+  thread.join();
+}
+
+}  // namespace injectx::stdext::coro::tests
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coro/when_all.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <functional>
+#include <latch>
+#include <thread>
+
+namespace injectx::stdext::coro::tests {
+
+namespace {
+
+task<int> child(thread_pool& pool, std::latch& together) {
+  co_await pool.schedule();
+  together.arrive_and_wait();
+  co_return 1;
+}
+
+}  // namespace
+
+TEST_CASE("size") {
+  REQUIRE(thread_pool{3}.size() == 3);
+  REQUIRE(thread_pool{0}.size() == 1);
+}
+
+TEST_CASE("schedule") {
+  thread_pool pool{2};
+  REQUIRE(pool.owns_current_thread() == false);
+
+  auto t = std::invoke(
+      [](thread_pool& pool) -> task<bool> {
+        co_await pool.schedule();
+        co_return pool.owns_current_thread();
+      },
+      pool);
+
+  REQUIRE(sync_wait(t));
+}
+
+TEST_CASE("destructor-drains") {
+  std::atomic<int> resumed{0};
+
+  {
+    thread_pool pool{2};
+    for (int i = 0; i < 100; ++i) {
+      spawn(pool.schedule(), [&resumed] {
+        resumed.fetch_add(1);
+      });
+    }
+  }
+
+  REQUIRE(resumed.load() == 100);
+}
+
+TEST_CASE("shared-queue-overflow") {
+  std::atomic<int> resumed{0};
+
+  {
+    thread_pool pool{1};
+    for (int i = 0; i < 5000; ++i) {
+      spawn(pool.schedule(), [&resumed] {
+        resumed.fetch_add(1);
+      });
+    }
+  }
+
+  REQUIRE(resumed.load() == 5000);
+}
+
+TEST_CASE("work-stealing") {
+  // every child blocks until all of them run at once, which only happens
+  // when idle workers steal them from the queue of the parent's worker
+  constexpr std::ptrdiff_t workers = 4;
+  thread_pool pool{workers};
+  std::latch together{workers};
+
+  auto parent = std::invoke(
+      [](thread_pool& pool, std::latch& together) -> task<int> {
+        co_await pool.schedule();
+
+        auto first = child(pool, together);
+        auto second = child(pool, together);
+        auto third = child(pool, together);
+        auto fourth = child(pool, together);
+        const auto [a, b, c, d] =
+            co_await when_all(first, second, third, fourth);
+        co_return a + b + c + d;
+      },
+      pool, together);
+
+  REQUIRE(sync_wait(parent) == 4);
+}
+
+}  // namespace injectx::stdext::coro::tests
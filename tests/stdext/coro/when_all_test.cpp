@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/when_all.hpp"
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace injectx::stdext::coro::tests {
+
+namespace {
+
+using Expected = stdext::expected<int, std::string>;
+
+task<int> square(thread_pool& pool, int value) {
+  co_await pool.schedule();
+  co_return value * value;
+}
+
+task<Expected> make(Expected value) {
+  co_return value;
+}
+
+task<stdext::expected<void, std::string>> nothing() {
+  co_return {};
+}
+
+}  // namespace
+
+TEST_CASE("empty") {
+  auto t = std::invoke([]() -> task<std::size_t> {
+    co_return std::tuple_size_v<decltype(co_await when_all())>;
+  });
+
+  REQUIRE(sync_wait(t) == 0);
+}
+
+TEST_CASE("results") {
+  auto number = std::invoke([]() -> task<int> {
+    co_return 42;
+  });
+
+  auto nothing = std::invoke([]() -> task<void> {
+    co_return;
+  });
+
+  auto t = std::invoke(
+      [](task<int>& number, task<void>& nothing) -> task<std::string> {
+        auto [n, v, p] = co_await when_all(
+            number, nothing, std::invoke([]() -> task<std::unique_ptr<int>> {
+              co_return std::make_unique<int>(7);
+            }));
+
+        STATIC_REQUIRE(std::same_as<decltype(v), std::monostate>);
+        co_return std::to_string(n + *p);
+      },
+      number, nothing);
+
+  REQUIRE(sync_wait(t) == "49");
+}
+
+TEST_CASE("exception") {
+  auto t = std::invoke([]() -> task<int> {
+    auto [a, b] = co_await when_all(
+        std::invoke([]() -> task<int> {
+          co_return 1;
+        }),
+        std::invoke([]() -> task<int> {
+          throw std::runtime_error{"failed"};
+          co_return 2;
+        }));
+
+    co_return a + b;
+  });
+
+  REQUIRE_THROWS_AS(sync_wait(t), std::runtime_error);
+}
+
+TEST_CASE("parallel") {
+  thread_pool pool{4};
+
+  auto t = std::invoke(
+      [](thread_pool& pool) -> task<int> {
+        const auto [a, b, c] = co_await when_all(
+            square(pool, 1), square(pool, 2), square(pool, 3));
+        co_return a + b + c;
+      },
+      pool);
+
+  REQUIRE(sync_wait(t) == 14);
+}
+
+TEST_CASE("range") {
+  thread_pool pool{4};
+
+  SECTION("lvalue") {
+    std::vector<task<int>> tasks;
+    for (int i = 0; i < 10; ++i) {
+      tasks.push_back(square(pool, i));
+    }
+
+    auto t = std::invoke(
+        [](std::vector<task<int>>& tasks) -> task<std::vector<int>> {
+          co_return co_await when_all(tasks);
+        },
+        tasks);
+
+    REQUIRE(sync_wait(t) == std::vector{0, 1, 4, 9, 16, 25, 36, 49, 64, 81});
+  }
+
+  SECTION("rvalue") {
+    std::vector<task<int>> tasks;
+    tasks.push_back(square(pool, 2));
+    tasks.push_back(square(pool, 3));
+
+    auto t = std::invoke(
+        [](std::vector<task<int>> tasks) -> task<std::vector<int>> {
+          co_return co_await when_all(std::move(tasks));
+        },
+        std::move(tasks));
+
+    REQUIRE(sync_wait(t) == std::vector{4, 9});
+  }
+
+  SECTION("empty") {
+    auto t = std::invoke([]() -> task<std::size_t> {
+      co_return (co_await when_all(std::vector<task<int>>{})).size();
+    });
+
+    REQUIRE(sync_wait(t) == 0);
+  }
+}
+
+TEST_CASE("collect") {
+  SECTION("values") {
+    auto t = std::invoke(
+        []() -> task<stdext::expected<std::tuple<int, std::monostate>,
+                                       std::string>> {
+          co_return collect(co_await when_all(make(1), nothing()));
+        });
+
+    const auto res = sync_wait(t);
+    REQUIRE(res.has_value());
+    REQUIRE(std::get<0>(res.value()) == 1);
+  }
+
+  SECTION("first-error") {
+    auto t = std::invoke(
+        []() -> task<stdext::expected<std::tuple<int, int, int>,
+                                       std::string>> {
+          co_return collect(co_await when_all(
+              make(1), make(stdext::unexpected{std::string{"second"}}),
+              make(stdext::unexpected{std::string{"third"}})));
+        });
+
+    const auto res = sync_wait(t);
+    REQUIRE(res.has_value() == false);
+    REQUIRE(res.error() == "second");
+  }
+
+  SECTION("range") {
+    std::vector<task<Expected>> tasks;
+    tasks.push_back(make(1));
+    tasks.push_back(make(2));
+
+    auto t = std::invoke(
+        [](std::vector<task<Expected>>& tasks)
+            -> task<stdext::expected<std::vector<int>, std::string>> {
+          co_return collect(co_await when_all(tasks));
+        },
+        tasks);
+
+    REQUIRE(sync_wait(t).value() == std::vector{1, 2});
+  }
+}
+
+}  // namespace injectx::stdext::coro::tests
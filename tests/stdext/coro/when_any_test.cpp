@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/coro/when_any.hpp"
+
+#include "injectx/stdext/coro/latch.hpp"
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/task.hpp"
+#include "injectx/stdext/coro/thread_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace injectx::stdext::coro::tests {
+
+namespace {
+
+// finishes once the latch is released
+task<int> after(const latch& released, int value) {
+  co_await released;
+  co_return value;
+}
+
+task<int> now(int value) {
+  co_return value;
+}
+
+task<int> scheduled(thread_pool& pool, int value) {
+  co_await pool.schedule();
+  co_return value;
+}
+
+}  // namespace
+
+TEST_CASE("first") {
+  latch never{1};
+
+  auto t = std::invoke(
+      [](const latch& never) -> task<std::variant<int, std::string>> {
+        co_return co_await when_any(
+            after(never, 1), std::invoke([]() -> task<std::string> {
+              co_return "second";
+            }));
+      },
+      never);
+
+  const auto res = sync_wait(t);
+  REQUIRE(res.index() == 1);
+  REQUIRE(std::get<1>(res) == "second");
+
+  // the first one is still running and finishes later
+  never.count_down();
+}
+
+TEST_CASE("void") {
+  auto t = std::invoke([]() -> task<std::size_t> {
+    const auto res = co_await when_any(std::invoke([]() -> task<void> {
+      co_return;
+    }));
+    co_return res.index();
+  });
+
+  REQUIRE(sync_wait(t) == 0);
+}
+
+TEST_CASE("exception") {
+  latch never{1};
+
+  auto t = std::invoke(
+      [](const latch& never) -> task<int> {
+        const auto res = co_await when_any(
+            std::invoke([]() -> task<int> {
+              throw std::runtime_error{"failed"};
+              co_return 1;
+            }),
+            after(never, 2));
+        co_return std::get<0>(res);
+      },
+      never);
+
+  REQUIRE_THROWS_AS(sync_wait(t), std::runtime_error);
+  never.count_down();
+}
+
+TEST_CASE("range") {
+  latch released{1};
+
+  std::vector<task<int>> tasks;
+  tasks.push_back(after(released, 0));
+  tasks.push_back(now(1));
+  tasks.push_back(now(2));
+
+  auto t = std::invoke(
+      [](std::vector<task<int>>& tasks) -> task<std::pair<std::size_t, int>> {
+        co_return co_await when_any(tasks);
+      },
+      tasks);
+
+  REQUIRE(sync_wait(t) == std::pair<std::size_t, int>{1, 1});
+  released.count_down();
+}
+
+TEST_CASE("parallel") {
+  thread_pool pool{4};
+  latch never{1};
+
+  auto t = std::invoke(
+      [](thread_pool& pool, const latch& never)
+          -> task<std::variant<int, int>> {
+        co_return co_await when_any(after(never, 1), scheduled(pool, 2));
+      },
+      pool, never);
+
+  REQUIRE(sync_wait(t).index() == 1);
+  never.count_down();
+}
+
+}  // namespace injectx::stdext::coro::tests
@@ -7,10 +7,72 @@
 
 #include <functional>
 #include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace injectx::stdext::tests {
 
+namespace {
+
+// counts copies of itself
+struct Counted {
+  int *copies;
+
+  Counted(int *copies) noexcept
+      : copies(copies) {
+  }
+
+  Counted(const Counted &that) noexcept
+      : copies(that.copies) {
+    ++*copies;
+  }
+
+  Counted &operator=(const Counted &) = delete;
+};
+
+generator<int> range(int first, int last) {
+  for (int i = first; i < last; ++i) {
+    co_yield i;
+  }
+}
+
+// yields 0..depth, every value from a nested generator one level deeper
+generator<int> nested(int depth) {
+  if (depth > 0) {
+    co_yield elements_of(nested(depth - 1));
+  }
+
+  co_yield depth;
+}
+
+generator<int> empty() {
+  co_return;
+}
+
+// every empty nested generator finishes without a single co_yield
+generator<int> manyEmpty(int count) {
+  for (int i = 0; i < count; ++i) {
+    co_yield elements_of(empty());
+  }
+
+  co_yield count;
+}
+
+}  // namespace
+
+TEST_CASE("concepts") {
+  STATIC_REQUIRE(std::ranges::input_range<generator<int>>);
+  STATIC_REQUIRE(std::ranges::view<generator<int>>);
+  STATIC_REQUIRE(
+      std::is_same_v<std::ranges::range_reference_t<generator<int>>, int &>);
+  STATIC_REQUIRE(std::is_same_v<
+                 std::ranges::range_reference_t<generator<const int>>,
+                 const int &>);
+}
+
 TEST_CASE("for-loop") {
   auto getValues = [](int max) -> generator<int> {
     for (int i = 0; i < max; ++i) {
@@ -64,4 +126,203 @@ TEST_CASE("optional") {
   REQUIRE(values == std::vector{Optional{10}});
 }
 
+TEST_CASE("no-copies") {
+  int copies = 0;
+
+  auto t = std::invoke(
+      [](int *copies) -> generator<Counted> {
+        Counted local{copies};
+        co_yield local;
+        co_yield Counted{copies};
+      },
+      &copies);
+
+  for (auto it = t.begin(); it != t.end(); ++it) {
+    REQUIRE((*it).copies == &copies);
+    REQUIRE(&*it == &*it);
+  }
+
+  REQUIRE(copies == 0);
+}
+
+TEST_CASE("const-lvalue-is-copied") {
+  int copies = 0;
+
+  auto t = std::invoke(
+      [](int *copies) -> generator<Counted> {
+        const Counted local{copies};
+        co_yield local;
+      },
+      &copies);
+
+  for ([[maybe_unused]] auto &v : t) {
+  }
+
+  REQUIRE(copies == 1);
+}
+
+TEST_CASE("move-out") {
+  auto t = std::invoke([]() -> generator<std::string> {
+    std::string local = "value";
+    co_yield local;
+    REQUIRE(local.empty());
+  });
+
+  auto it = t.begin();
+  const auto value = std::move(*it);
+  REQUIRE(value == "value");
+  ++it;
+  REQUIRE(it == t.end());
+}
+
+TEST_CASE("views") {
+  auto t = std::invoke([]() -> generator<int> {
+    for (int i = 0; i < 5; ++i) {
+      co_yield i;
+    }
+  });
+
+  // a generator is a move-only view, as std::generator
+  auto tens = std::move(t) | std::views::filter([](int v) {
+                return v % 2 == 0;
+              })
+              | std::views::transform([](int v) {
+                  return v * 10;
+                });
+
+  std::vector<int> values;
+  for (const auto v : tens) {
+    values.push_back(v);
+  }
+
+  REQUIRE(values == std::vector{0, 20, 40});
+}
+
+TEST_CASE("exception") {
+  auto t = std::invoke([]() -> generator<int> {
+    co_yield 1;
+    throw std::runtime_error{"failed"};
+  });
+
+  auto it = t.begin();
+  REQUIRE(*it == 1);
+  REQUIRE_THROWS_AS(++it, std::runtime_error);
+  REQUIRE(it == t.end());
+}
+
+TEST_CASE("elements-of") {
+  SECTION("generator") {
+    auto t = std::invoke([]() -> generator<int> {
+      co_yield 0;
+      co_yield elements_of(range(1, 3));
+      co_yield 3;
+      co_yield elements_of(range(4, 4));
+      co_yield elements_of(range(4, 6));
+    });
+
+    std::vector<int> values;
+    for (const auto v : t) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values == std::vector{0, 1, 2, 3, 4, 5});
+  }
+
+  SECTION("lvalue-generator") {
+    auto t = std::invoke([]() -> generator<int> {
+      auto inner = range(0, 2);
+      co_yield elements_of(inner);
+      co_yield elements_of(inner);
+      co_yield 2;
+    });
+
+    std::vector<int> values;
+    for (const auto v : t) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values == std::vector{0, 1, 2});
+  }
+
+  SECTION("range") {
+    auto t = std::invoke([]() -> generator<std::string> {
+      const std::vector<std::string> lvalue{"a", "b"};
+      co_yield elements_of(lvalue);
+
+      std::vector<std::string_view> converted;
+      converted.emplace_back("c");
+      co_yield elements_of(std::move(converted));
+    });
+
+    std::vector<std::string> values;
+    for (const auto &v : t) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values == std::vector<std::string>{"a", "b", "c"});
+  }
+
+  SECTION("deep") {
+    std::vector<int> values;
+    for (const auto v : nested(100)) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values.size() == 101);
+    REQUIRE(values.front() == 0);
+    REQUIRE(values.back() == 100);
+  }
+
+  SECTION("many-empty") {
+    std::vector<int> values;
+    for (const auto v : manyEmpty(1'000'000)) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values == std::vector{1'000'000});
+  }
+
+  SECTION("exception") {
+    auto t = std::invoke([]() -> generator<int> {
+      bool failed = false;
+      try {
+        co_yield elements_of(std::invoke([]() -> generator<int> {
+          co_yield 1;
+          throw std::runtime_error{"failed"};
+        }));
+      } catch (const std::runtime_error &) {
+        failed = true;
+      }
+
+      if (failed) {
+        co_yield 2;
+      }
+    });
+
+    std::vector<int> values;
+    for (const auto v : t) {
+      values.push_back(v);
+    }
+
+    REQUIRE(values == std::vector{1, 2});
+  }
+
+  SECTION("uncaught-exception") {
+    auto t = std::invoke([]() -> generator<int> {
+      co_yield elements_of(std::invoke([]() -> generator<int> {
+        throw std::runtime_error{"failed"};
+        co_return;
+      }));
+    });
+
+    REQUIRE_THROWS_AS(t.begin(), std::runtime_error);
+  }
+
+  SECTION("destroyed-while-nested") {
+    auto t = nested(3);
+    auto it = t.begin();
+    REQUIRE(*it == 0);
+  }
+}
+
 }  // namespace injectx::stdext::tests
@@ -123,4 +123,51 @@ TEST_CASE("for-loop") {
   STATIC_REQUIRE(values.at(2) == 1);
 }
 
+TEST_CASE("frozen-make") {
+  using Map = frozen_static_map<std::string_view, int, 4>;
+
+  constexpr auto map =
+      Map::make({{{"c", 1}, {"a", 2}, {"d", 3}, {"b", 4}}}).value();
+  STATIC_REQUIRE(map.size() == 4);
+  STATIC_REQUIRE(map.max_size() == 4);
+  STATIC_REQUIRE(map.empty() == false);
+
+  STATIC_REQUIRE(map.begin()[0] == std::pair{std::string_view{"a"}, 2});
+  STATIC_REQUIRE(map.begin()[1] == std::pair{std::string_view{"b"}, 4});
+  STATIC_REQUIRE(map.begin()[2] == std::pair{std::string_view{"c"}, 1});
+  STATIC_REQUIRE(map.begin()[3] == std::pair{std::string_view{"d"}, 3});
+
+  STATIC_REQUIRE(map.find("a")->second == 2);
+  STATIC_REQUIRE(map.find("d")->second == 3);
+  STATIC_REQUIRE(map.find("e") == map.end());
+  STATIC_REQUIRE(map.find("0") == map.end());
+}
+
+TEST_CASE("frozen-duplicate-keys") {
+  using Map = frozen_static_map<std::string_view, int, 5>;
+
+  constexpr auto map =
+      Map::make({{{"c", 1}, {"a", 2}, {"c", 3}, {"a", 4}, {"b", 5}}});
+  STATIC_REQUIRE(map.has_value() == false);
+  STATIC_REQUIRE(map.error().first == 0);
+  STATIC_REQUIRE(map.error().second == 2);
+}
+
+TEST_CASE("freeze") {
+  static constexpr auto map = std::invoke([] {
+    static_map<std::string_view, int, 4> m;
+    (void)m.try_emplace("b", 3);
+    (void)m.try_emplace("a", 2);
+    (void)m.try_emplace("c", 4);
+    return m.freeze();
+  });
+
+  STATIC_REQUIRE(map.size() == 3);
+  STATIC_REQUIRE(map.max_size() == 4);
+  STATIC_REQUIRE(map.begin()->first == "a");
+  STATIC_REQUIRE(map.find("b")->second == 3);
+  STATIC_REQUIRE(map.find("c")->second == 4);
+  STATIC_REQUIRE(map.find("d") == map.end());
+}
+
 }  // namespace injectx::stdext::tests
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/static_mpmc_queue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace injectx::stdext::tests {
+
+TEST_CASE("initial-state") {
+  const static_mpmc_queue<int, 4> queue;
+  REQUIRE(queue.empty());
+  REQUIRE(queue.size() == 0);
+  REQUIRE(queue.max_size() == 4);
+}
+
+TEST_CASE("slot-per-cache-line") {
+  // the slots, the tail and the head
+  STATIC_REQUIRE(
+      sizeof(static_mpmc_queue<int, 4>) == 6 * details::cache_line_size);
+}
+
+TEST_CASE("push-and-pop") {
+  static_mpmc_queue<int, 4> queue;
+
+  REQUIRE(queue.push(1).has_value());
+  REQUIRE(queue.push(2).has_value());
+  REQUIRE(queue.push(3).has_value());
+  REQUIRE(queue.push(4).has_value());
+  REQUIRE(queue.size() == 4);
+
+  const auto full = queue.push(5);
+  REQUIRE(full.has_value() == false);
+  REQUIRE(full.error() == std::string_view{"queue is full"});
+
+  REQUIRE(queue.pop().value() == 1);
+  REQUIRE(queue.pop().value() == 2);
+  REQUIRE(queue.push(5).has_value());
+  REQUIRE(queue.pop().value() == 3);
+  REQUIRE(queue.pop().value() == 4);
+  REQUIRE(queue.pop().value() == 5);
+
+  const auto empty = queue.pop();
+  REQUIRE(empty.has_value() == false);
+  REQUIRE(empty.error() == std::string_view{"queue is empty"});
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("wrap-around") {
+  static_mpmc_queue<int, 2> queue;
+
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(queue.push(i).has_value());
+    REQUIRE(queue.push(i + 1).has_value());
+    REQUIRE(queue.pop().value() == i);
+    REQUIRE(queue.pop().value() == i + 1);
+  }
+
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("move-only") {
+  static_mpmc_queue<std::unique_ptr<int>, 2> queue;
+
+  REQUIRE(queue.push(std::make_unique<int>(10)).has_value());
+  auto value = queue.pop();
+  REQUIRE(value.has_value());
+  REQUIRE(**value == 10);
+}
+
+TEST_CASE("not-default-constructible") {
+  struct counted {
+    explicit counted(std::shared_ptr<int> alive) noexcept
+        : alive(std::move(alive)) {
+    }
+
+    std::shared_ptr<int> alive;
+  };
+
+  const auto alive = std::make_shared<int>(0);
+  {
+    static_mpmc_queue<counted, 4> queue;
+    const counted value{alive};
+    REQUIRE(queue.push(value).has_value());
+    REQUIRE(queue.push(counted{alive}).has_value());
+    REQUIRE(queue.push(counted{alive}).has_value());
+    REQUIRE(alive.use_count() == 5);
+
+    REQUIRE(queue.pop().has_value());
+    REQUIRE(alive.use_count() == 4);
+  }
+
+  // the values left in the queue are destroyed with it
+  REQUIRE(alive.use_count() == 1);
+}
+
+TEST_CASE("parallel") {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int values = 10000;
+
+  static_mpmc_queue<int, 64> queue;
+  std::atomic<long> sum{0};
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue] {
+      for (int i = 1; i <= values; ++i) {
+        while (!queue.push(i).has_value()) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      while (consumed.load() < producers * values) {
+        if (auto value = queue.pop(); value.has_value()) {
+          sum += value.value();
+          ++consumed;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(consumed == producers * values);
+  REQUIRE(sum == producers * (values * (values + 1L) / 2));
+  REQUIRE(queue.empty());
+}
+
+}  // namespace injectx::stdext::tests
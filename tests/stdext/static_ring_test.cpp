@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright 2024 Mikhail Svetkin
+// SPDX-License-Identifier: MIT
+
+#include "injectx/stdext/static_ring.hpp"
+
+#include "injectx/stdext/coro/sync_wait.hpp"
+#include "injectx/stdext/coro/task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace injectx::stdext::tests {
+
+namespace {
+
+using Ring = static_ring<int, 8>;
+
+// pops count values, waiting whenever the ring is empty
+coro::task<long> consume(Ring &ring, int count) {
+  long sum = 0;
+  for (int i = 0; i < count; ++i) {
+    co_await ring.wait_not_empty();
+    sum += ring.pop().value();
+  }
+
+  co_return sum;
+}
+
+// pushes 1..count, waiting whenever the ring is full
+coro::task<void> produce(Ring &ring, int count) {
+  for (int i = 1; i <= count; ++i) {
+    co_await ring.wait_not_full();
+    (void)ring.push(i);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("initial-state") {
+  const Ring ring;
+  REQUIRE(ring.empty());
+  REQUIRE(ring.size() == 0);
+  REQUIRE(ring.max_size() == 8);
+}
+
+TEST_CASE("push-and-pop") {
+  static_ring<int, 2> ring;
+
+  REQUIRE(ring.push(1).has_value());
+  REQUIRE(ring.push(2).has_value());
+
+  const auto full = ring.push(3);
+  REQUIRE(full.has_value() == false);
+  REQUIRE(full.error() == std::string_view{"queue is full"});
+
+  REQUIRE(ring.pop().value() == 1);
+  REQUIRE(ring.push(3).has_value());
+  REQUIRE(ring.pop().value() == 2);
+  REQUIRE(ring.pop().value() == 3);
+
+  const auto empty = ring.pop();
+  REQUIRE(empty.has_value() == false);
+  REQUIRE(empty.error() == std::string_view{"queue is empty"});
+}
+
+TEST_CASE("move-only") {
+  static_ring<std::unique_ptr<int>, 2> ring;
+
+  REQUIRE(ring.push(std::make_unique<int>(10)).has_value());
+  REQUIRE(*ring.pop().value() == 10);
+}
+
+TEST_CASE("batch") {
+  Ring ring;
+  const std::array values{1, 2, 3, 4, 5, 6};
+
+  REQUIRE(ring.push(std::span<const int>{values}) == 6);
+  REQUIRE(ring.push(std::span<const int>{values}) == 2);
+  REQUIRE(ring.size() == 8);
+
+  std::array<int, 5> out{};
+  REQUIRE(ring.pop(std::span<int>{out}) == 5);
+  REQUIRE(out == std::array{1, 2, 3, 4, 5});
+
+  // wraps around the end of the ring
+  REQUIRE(ring.push(std::span<const int>{values}.first(4)) == 4);
+  REQUIRE(ring.pop(std::span<int>{out}) == 5);
+  REQUIRE(out == std::array{6, 1, 2, 1, 2});
+  REQUIRE(ring.pop(std::span<int>{out}) == 2);
+  REQUIRE(out[0] == 3);
+  REQUIRE(out[1] == 4);
+  REQUIRE(ring.pop(std::span<int>{out}) == 0);
+}
+
+TEST_CASE("wait") {
+  Ring ring;
+
+  SECTION("ready") {
+    REQUIRE(ring.push(1).has_value());
+    REQUIRE(coro::sync_wait(consume(ring, 1)) == 1);
+  }
+
+  SECTION("not-empty") {
+    auto consumer = consume(ring, 3);
+    std::thread producer{[&ring] {
+      for (int i = 1; i <= 3; ++i) {
+        while (!ring.push(i).has_value()) {
+          std::this_thread::yield();
+        }
+      }
+    }};
+
+    REQUIRE(coro::sync_wait(consumer) == 6);
+    producer.join();
+  }
+
+  SECTION("not-full") {
+    auto producer = produce(ring, 20);
+    std::thread consumer{[&ring] {
+      for (int popped = 0; popped < 20;) {
+        popped += ring.pop().has_value() ? 1 : 0;
+      }
+    }};
+
+    coro::sync_wait(producer);
+    consumer.join();
+    REQUIRE(ring.empty());
+  }
+}
+
+TEST_CASE("parallel") {
+  constexpr int count = 100000;
+  Ring ring;
+
+  auto consumer = consume(ring, count);
+  std::thread producer{[&ring] {
+    coro::sync_wait(produce(ring, count));
+  }};
+
+  REQUIRE(coro::sync_wait(consumer) == count * (count + 1L) / 2);
+  producer.join();
+  REQUIRE(ring.empty());
+}
+
+}  // namespace injectx::stdext::tests